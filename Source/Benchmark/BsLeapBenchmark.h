@@ -0,0 +1,14 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsApplication.h"
+
+namespace bs
+{
+	/** Compares moving hand joints one at a time against batching them through LeapJointWriter. */
+	void runJointWriterBenchmark();
+
+	/** Compares transforming frames through the batched kernel of LeapFrameUtility against a member by member path. */
+	void runFrameTransformBenchmark();
+}
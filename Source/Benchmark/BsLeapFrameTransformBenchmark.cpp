@@ -0,0 +1,159 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "BsLeapBenchmark.h"
+#include "Leap/BsLeapFrameUtility.h"
+#include "Math/BsMatrix4.h"
+#include "Scene/BsTransform.h"
+#include "Utility/BsTime.h"
+
+#include <cstdio>
+#include <cstring>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Measures the time spent moving a frame from Leap space to world space, through the structure of arrays kernel of
+// LeapFrameUtility and one member at a time, with a matrix multiply per joint and a quaternion multiply per bone.
+//
+// Both paths cover the full pose: palm positions, velocity, direction and normal, every joint and every orientation.
+// Each kind of transformation is measured on its own, as the kernel takes a shortcut for all but the affine one. Hands
+// are copied back from their Leap space source before every transformation, in both paths, so that values don't drift
+// into denormals.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace bs
+{
+	namespace
+	{
+		constexpr UINT32 NUM_HANDS = 2;
+		constexpr UINT32 NUM_WARMUP_FRAMES = 1000;
+		constexpr UINT32 NUM_FRAMES = 100000;
+
+		/** Fills @p hands with a plausible pose, in millimeters. */
+		void createHands(LeapHand* hands)
+		{
+			for (UINT32 h = 0; h < NUM_HANDS; h++)
+			{
+				LeapHand& hand = hands[h];
+				std::memset(&hand, 0, sizeof(hand));
+				hand.mId = h;
+
+				Vector3 palm(h * 150.0f - 75.0f, 200.0f, 0.0f);
+				hand.mPalm.mPosition = palm;
+				hand.mPalm.mStabilizedPosition = palm;
+				hand.mPalm.mVelocity = Vector3(10.0f, -5.0f, 2.0f);
+				hand.mPalm.mNormal = Vector3(0.0f, -1.0f, 0.0f);
+				hand.mPalm.mDirection = Vector3(0.0f, 0.0f, -1.0f);
+				hand.mPalm.mOrientation = Quaternion::IDENTITY;
+
+				for (UINT32 f = 0; f < 5; f++)
+				{
+					for (UINT32 b = 0; b < 4; b++)
+					{
+						LeapBone& bone = hand.mDigits[f].mBones[b];
+						bone.mPrevJoint = palm + Vector3((f - 2.0f) * 20.0f, 0.0f, -30.0f * b);
+						bone.mNextJoint = palm + Vector3((f - 2.0f) * 20.0f, 0.0f, -30.0f * (b + 1));
+						bone.mRotation = Quaternion::IDENTITY;
+					}
+				}
+
+				hand.mArm.mPrevJoint = palm + Vector3(0.0f, 0.0f, 250.0f);
+				hand.mArm.mNextJoint = palm + Vector3(0.0f, 0.0f, 50.0f);
+				hand.mArm.mRotation = Quaternion::IDENTITY;
+			}
+		}
+
+		/** Transforms the hands of @p frame one member at a time. */
+		void transformPerBone(LeapFrame* frame, const Transform& transform)
+		{
+			Matrix4 matrix = transform.getMatrix();
+			Matrix4 normalMatrix = matrix.inverseAffine().transpose();
+			const Quaternion& rotation = transform.getRotation();
+
+			for (UINT32 i = 0; i < frame->mNumberOfHands; i++)
+			{
+				LeapHand& hand = frame->mHands[i];
+
+				LeapPalm& palm = hand.mPalm;
+				palm.mPosition = matrix.multiplyAffine(palm.mPosition);
+				palm.mStabilizedPosition = matrix.multiplyAffine(palm.mStabilizedPosition);
+				palm.mVelocity = matrix.multiplyDirection(palm.mVelocity);
+				palm.mNormal = Vector3::normalize(normalMatrix.multiplyDirection(palm.mNormal));
+				palm.mDirection = Vector3::normalize(matrix.multiplyDirection(palm.mDirection));
+				palm.mOrientation = rotation * palm.mOrientation;
+
+				auto transformBone = [&](LeapBone& bone)
+				{
+					bone.mPrevJoint = matrix.multiplyAffine(bone.mPrevJoint);
+					bone.mNextJoint = matrix.multiplyAffine(bone.mNextJoint);
+					bone.mRotation = rotation * bone.mRotation;
+				};
+
+				for (auto& digit : hand.mDigits)
+				{
+					for (auto& bone : digit.mBones)
+						transformBone(bone);
+				}
+
+				transformBone(hand.mArm);
+			}
+		}
+
+		/** Transforms a frame over and over through either path, and prints how long a frame took. */
+		void runBenchmark(const char* name, const Transform& transform, bool isBatched)
+		{
+			LeapHand source[NUM_HANDS];
+			createHands(source);
+
+			LeapHand hands[NUM_HANDS];
+			LeapFrame frame;
+			std::memset(&frame, 0, sizeof(frame));
+			frame.mNumberOfHands = NUM_HANDS;
+			frame.mHands = hands;
+
+			float checksum = 0.0f;
+			UINT64 start = 0;
+			for (UINT32 i = 0; i < NUM_WARMUP_FRAMES + NUM_FRAMES; i++)
+			{
+				if (i == NUM_WARMUP_FRAMES)
+					start = gTime().getTimePrecise();
+
+				std::memcpy(hands, source, sizeof(hands));
+
+				if (isBatched)
+					LeapFrameUtility::transform(&frame, transform);
+				else
+					transformPerBone(&frame, transform);
+
+				checksum += hands[i % NUM_HANDS].mDigits[i % 5].mBones[3].mNextJoint.y;
+			}
+
+			UINT64 elapsed = gTime().getTimePrecise() - start;
+
+			printf("%-23s %-9s %8.1f ns/frame  (checksum %g)\n", name, isBatched ? "batched" : "per bone",
+				elapsed * 1000.0 / NUM_FRAMES, checksum);
+		}
+	}
+
+	void runFrameTransformBenchmark()
+	{
+		printf("%u hands per frame, %u frames\n", NUM_HANDS, NUM_FRAMES);
+
+		Vector3 position(0.0f, 1.0f, -0.5f);
+		Quaternion rotation(Degree(0.0f), Degree(30.0f), Degree(0.0f));
+		struct
+		{
+			const char* name;
+			Transform transform;
+		} cases[] =
+		{
+			{ "translate", Transform(position, Quaternion::IDENTITY, Vector3::ONE) },
+			{ "translate uniform scale", Transform(position, Quaternion::IDENTITY, Vector3(0.001f, 0.001f, 0.001f)) },
+			{ "affine", Transform(position, rotation, Vector3(0.001f, 0.002f, 0.001f)) }
+		};
+
+		for (auto& entry : cases)
+		{
+			runBenchmark(entry.name, entry.transform, false);
+			runBenchmark(entry.name, entry.transform, true);
+		}
+	}
+}
@@ -0,0 +1,202 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "BsLeapBenchmark.h"
+#include "Scene/BsSceneObject.h"
+#include "Utility/BsTime.h"
+#include "Leap/BsLeapJointWriter.h"
+
+#include <cstdio>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Measures the time spent moving the joints of four graphics hands and four physics hands, written one at a time like
+// hand models used to, and batched through LeapJointWriter like CLeapHandModelManager does now.
+//
+// Graphics hands nest their joints the way skeletal hands do: palm under the wrist, then every finger under the palm
+// through a grouping object that isn't written, with each bone under the previous one. Physics hands keep their joints
+// as siblings, the way rigid hands do for their rigidbodies. Every frame the world transforms are read back, as
+// rendering and physics would.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace bs
+{
+	namespace
+	{
+		constexpr UINT32 NUM_HANDS = 4;
+		constexpr UINT32 NUM_FINGERS = 5;
+		constexpr UINT32 NUM_BONES = 4;
+		constexpr UINT32 NUM_JOINTS = 2 + NUM_FINGERS * NUM_BONES;
+
+		constexpr UINT32 NUM_WARMUP_FRAMES = 100;
+		constexpr UINT32 NUM_FRAMES = 2000;
+
+		/** Scene objects of a single hand, with joints in the order their positions are generated. */
+		struct BenchmarkHand
+		{
+			HSceneObject mRoot;
+			HSceneObject mJoints[NUM_JOINTS];
+		};
+
+		/** Creates a hand whose joints are nested like a skeletal hand. */
+		BenchmarkHand createGraphicsHand(UINT32 index)
+		{
+			BenchmarkHand hand;
+			hand.mRoot = SceneObject::create("GraphicsHand" + toString(index));
+
+			HSceneObject wrist = SceneObject::create("wrist");
+			wrist->setParent(hand.mRoot);
+			hand.mJoints[0] = wrist;
+
+			HSceneObject palm = SceneObject::create("palm");
+			palm->setParent(wrist);
+			hand.mJoints[1] = palm;
+
+			for (UINT32 f = 0; f < NUM_FINGERS; f++)
+			{
+				HSceneObject finger = SceneObject::create("finger" + toString(f));
+				finger->setParent(palm);
+
+				HSceneObject parent = finger;
+				for (UINT32 b = 0; b < NUM_BONES; b++)
+				{
+					HSceneObject bone = SceneObject::create("bone" + toString(b));
+					bone->setParent(parent);
+
+					hand.mJoints[2 + f * NUM_BONES + b] = bone;
+					parent = bone;
+				}
+			}
+
+			return hand;
+		}
+
+		/** Creates a hand whose joints are siblings, like a rigid hand. */
+		BenchmarkHand createPhysicsHand(UINT32 index)
+		{
+			BenchmarkHand hand;
+			hand.mRoot = SceneObject::create("PhysicsHand" + toString(index));
+
+			for (UINT32 i = 0; i < NUM_JOINTS; i++)
+			{
+				hand.mJoints[i] = SceneObject::create("joint" + toString(i));
+				hand.mJoints[i]->setParent(hand.mRoot);
+			}
+
+			return hand;
+		}
+
+		/** Returns the world position of a joint of a hand at a frame, moving smoothly from frame to frame. */
+		Vector3 getJointPosition(UINT32 hand, UINT32 joint, UINT32 frame)
+		{
+			float phase = frame * 0.01f + hand;
+			Vector3 palm(hand * 0.3f + Math::sin(phase) * 0.05f, 1.0f + Math::cos(phase) * 0.05f, 0.5f);
+
+			if (joint < 2)
+				return palm - Vector3(0.0f, 0.0f, 0.08f * (1 - joint));
+
+			UINT32 finger = (joint - 2) / NUM_BONES;
+			UINT32 bone = (joint - 2) % NUM_BONES;
+			float curl = Math::sin(phase * 2.0f + finger) * 0.01f;
+
+			return palm + Vector3((finger - 2.0f) * 0.02f, curl * bone, 0.03f * (bone + 1));
+		}
+
+		/** Reads back the world position of every joint, forcing the transforms to resolve. */
+		float readBack(const BenchmarkHand* hands)
+		{
+			float sum = 0.0f;
+			for (UINT32 h = 0; h < NUM_HANDS; h++)
+			{
+				for (auto& joint : hands[h].mJoints)
+					sum += joint->getTransform().getPosition().y;
+			}
+
+			return sum;
+		}
+
+		/** Moves the joints of every hand for a frame, either one at a time or through @p writer. */
+		void writeHands(const BenchmarkHand* hands, UINT32 frame, LeapJointWriter* writer)
+		{
+			for (UINT32 h = 0; h < NUM_HANDS; h++)
+			{
+				for (UINT32 j = 0; j < NUM_JOINTS; j++)
+				{
+					Vector3 position = getJointPosition(h, j, frame);
+					if (writer != nullptr)
+						writer->setWorldPosition(hands[h].mJoints[j], position);
+					else
+						hands[h].mJoints[j]->setWorldPosition(position);
+				}
+			}
+
+			if (writer != nullptr)
+				writer->commit();
+		}
+
+		/** Returns the largest distance between a joint and the position it was last written. */
+		float getMaxError(const BenchmarkHand* hands, UINT32 frame)
+		{
+			float maxError = 0.0f;
+			for (UINT32 h = 0; h < NUM_HANDS; h++)
+			{
+				for (UINT32 j = 0; j < NUM_JOINTS; j++)
+				{
+					Vector3 error = hands[h].mJoints[j]->getTransform().getPosition() - getJointPosition(h, j, frame);
+					maxError = std::max(maxError, error.length());
+				}
+			}
+
+			return maxError;
+		}
+
+		/** Runs the frames with joints written one at a time, or batched if @p isBatched, and prints how long they took. */
+		void runBenchmark(const BenchmarkHand* graphicsHands, const BenchmarkHand* physicsHands, bool isBatched)
+		{
+			LeapJointWriter graphicsWriter;
+			LeapJointWriter physicsWriter;
+
+			float checksum = 0.0f;
+			UINT64 start = 0;
+			for (UINT32 frame = 0; frame < NUM_WARMUP_FRAMES + NUM_FRAMES; frame++)
+			{
+				if (frame == NUM_WARMUP_FRAMES)
+					start = gTime().getTimePrecise();
+
+				writeHands(graphicsHands, frame, isBatched ? &graphicsWriter : nullptr);
+				writeHands(physicsHands, frame, isBatched ? &physicsWriter : nullptr);
+
+				checksum += readBack(graphicsHands) + readBack(physicsHands);
+			}
+
+			UINT64 elapsed = gTime().getTimePrecise() - start;
+
+			UINT32 lastFrame = NUM_WARMUP_FRAMES + NUM_FRAMES - 1;
+			float maxError = std::max(getMaxError(graphicsHands, lastFrame), getMaxError(physicsHands, lastFrame));
+
+			printf("%-13s %8.2f us/frame  max error %g  (checksum %g)\n", isBatched ? "batched" : "one at a time",
+				(double)elapsed / NUM_FRAMES, maxError, checksum);
+		}
+	}
+
+	void runJointWriterBenchmark()
+	{
+		BenchmarkHand graphicsHands[NUM_HANDS];
+		BenchmarkHand physicsHands[NUM_HANDS];
+		for (UINT32 i = 0; i < NUM_HANDS; i++)
+		{
+			graphicsHands[i] = createGraphicsHand(i);
+			physicsHands[i] = createPhysicsHand(i);
+		}
+
+		printf("%u graphics and %u physics hands, %u joints each, %u frames\n", NUM_HANDS, NUM_HANDS, NUM_JOINTS,
+			NUM_FRAMES);
+
+		runBenchmark(graphicsHands, physicsHands, false);
+		runBenchmark(graphicsHands, physicsHands, true);
+
+		for (UINT32 i = 0; i < NUM_HANDS; i++)
+		{
+			graphicsHands[i].mRoot->destroy();
+			physicsHands[i].mRoot->destroy();
+		}
+	}
+}
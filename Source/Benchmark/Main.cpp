@@ -0,0 +1,20 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "BsLeapBenchmark.h"
+
+int main()
+{
+	using namespace bs;
+
+	// Scene objects need a running application, though no frame is ever rendered
+	VideoMode videoMode(320, 240);
+	Application::startUp(videoMode, "LeapBenchmark", false);
+
+	runJointWriterBenchmark();
+	runFrameTransformBenchmark();
+
+	Application::shutDown();
+
+	return 0;
+}
@@ -22,12 +22,29 @@ namespace bs
 
 	void CLeapCapsuleHand::onInitModel()
 	{
+		refreshRig();
+
 		if (mMaterial != NULL)
 		{
 			//mSphereMaterial = new Material(mMaterial);
 		}
 	}
 
+	void CLeapCapsuleHand::onBindRig()
+	{
+		// Added in the order of the indices returned by getRigFingerIndex() and getRigBoneIndex()
+		mRig.addJoint("palm");
+
+		for (int i = 0; i < 5; ++i)
+		{
+			String finger = "finger" + toString(i);
+			mRig.addJoint(finger);
+
+			for (int j = 0; j < 3; ++j)
+				mRig.addJoint(finger + "/bone" + toString(j));
+		}
+	}
+
 	void CLeapCapsuleHand::begin()
 	{
 		CLeapHandModelBase::begin();
@@ -55,22 +72,25 @@ namespace bs
 		if (!mHand)
 			return;
 
-		String suffix = (mChirality == eLeapHandType_Left) ? "_L" : "_R";
+		refreshRig();
 
-		HSceneObject palm = SO()->findChild("palm");
-		palm->setWorldPosition(mHand->mPalm.mPosition);
+		const HSceneObject& palm = mRig.getJoint(RIG_PALM);
+		if (palm != NULL)
+			setJointWorldPosition(palm, mHand->mPalm.mPosition);
 
 		for (int i = 0; i < 5; ++i)
 		{
 			const LeapFinger& leapFinger = mHand->mDigits[i];
 
-			HSceneObject finger = SO()->findChild("finger" + toString(i));
-			finger->setWorldPosition(leapFinger.mBones[0].mNextJoint);
+			const HSceneObject& finger = mRig.getJoint(getRigFingerIndex(i));
+			if (finger != NULL)
+				setJointWorldPosition(finger, leapFinger.mBones[0].mNextJoint);
 
 			for (int j = 0; j < 3; ++j)
 			{
-				HSceneObject bone = finger->findChild("bone" + toString(j));
-				bone->setWorldPosition(leapFinger.mBones[j + 1].mNextJoint);
+				const HSceneObject& bone = mRig.getJoint(getRigBoneIndex(i, j));
+				if (bone != NULL)
+					setJointWorldPosition(bone, leapFinger.mBones[j + 1].mNextJoint);
 			}
 		}
 
@@ -43,7 +43,20 @@ namespace bs
 		/** @copydoc CLeapHandModelBase::updateFrame */
 		void updateFrame() override;
 
+	protected:
+		/** @copydoc CLeapHandModelBase::onBindRig */
+		void onBindRig() override;
+
 	private:
+		/** Returns the index in mRig of the scene object of a finger. */
+		static UINT32 getRigFingerIndex(int fingerIndex) { return 1 + fingerIndex * 4; }
+
+		/** Returns the index in mRig of the scene object of a bone of a finger, past its base. */
+		static UINT32 getRigBoneIndex(int fingerIndex, int boneIndex)
+		{
+			return getRigFingerIndex(fingerIndex) + 1 + boneIndex;
+		}
+
 		void onValidate();
 
 		void drawSphere(Vector3 position);
@@ -70,6 +83,9 @@ namespace bs
 		const int THUMB_BASE_INDEX = (int)LeapFinger::TYPE_THUMB * 4;
 		const int PINKY_BASE_INDEX = (int)LeapFinger::TYPE_PINKY * 4;
 
+		/** Index in mRig of the scene object of the palm. */
+		static constexpr UINT32 RIG_PALM = 0;
+
 		static const int _leftColorIndex = 0;
 		static const int _rightColorIndex = 0;
 		static const Color _leftColorList[];
@@ -28,6 +28,14 @@ namespace bs
 		updateFrame();
 	}
 
+	void CLeapFingerModel::setJointWorldPosition(const HSceneObject& joint, const Vector3& position)
+	{
+		if (mJointWriter != NULL)
+			mJointWriter->setWorldPosition(joint, position);
+		else
+			joint->setWorldPosition(position);
+	}
+
 	Vector3 CLeapFingerModel::getTipPosition()
 	{
 		if (mFinger != NULL)
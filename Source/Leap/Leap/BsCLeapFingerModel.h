@@ -4,6 +4,7 @@
 
 #include "Math/BsRay.h"
 #include "Leap/BsLeapFrame.h"
+#include "Leap/BsLeapJointWriter.h"
 #include "Scene/BsSceneObject.h"
 
 namespace bs
@@ -27,6 +28,12 @@ namespace bs
 		/** Sets the Leap hand and finger data for this finger. */
 		void setLeapHand(const LeapHand* hand);
 
+		/**
+		 * Sets the writer batching the joint positions set by the finger, or null to set them immediately. For internal
+		 * use.
+		 */
+		void _setJointWriter(LeapJointWriter* writer) { mJointWriter = writer; }
+
 		/**
 		* Implement this function to initialize this finger after it is created.
 		* Typically, this function is called by the parent CLeapHandModel component.
@@ -92,9 +99,14 @@ namespace bs
 		HSceneObject mJoints[NUM_BONES - 1];
 
 	protected:
+		/** Sets the world position of a bone or joint, through the joint writer if the finger has one. */
+		void setJointWorldPosition(const HSceneObject& joint, const Vector3& position);
+
 		/** Latest Leap hand data. */
 		const LeapHand* mHand;
 
+		LeapJointWriter* mJointWriter = NULL;
+
 		/** Latest Leap finger data. */
 		const LeapFinger* mFinger;
 
@@ -130,6 +130,18 @@ namespace bs
 		}
 	}
 
+	void CLeapHandModel::_setJointWriter(LeapJointWriter* writer)
+	{
+		CLeapHandModelBase::_setJointWriter(writer);
+
+		// Fingers are updated by the hand, so their joints are committed along with the hand's
+		for (int i = 0; i < NUM_FINGERS; ++i)
+		{
+			if (mFingers[i] != NULL)
+				mFingers[i]->_setJointWriter(writer);
+		}
+	}
+
 	void CLeapHandModel::onInitModel()
 	{
 		for (int f = 0; f < NUM_FINGERS; ++f)
@@ -70,6 +70,9 @@ namespace bs
 
 		void setLeapHand(const LeapHand* hand) override;
 
+		/** @copydoc CLeapHandModelBase::_setJointWriter */
+		void _setJointWriter(LeapJointWriter* writer) override;
+
 		/** @copydoc CLeapHandModelBase::onInitModel */
 		void onInitModel() override;
 
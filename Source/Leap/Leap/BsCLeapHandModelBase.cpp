@@ -7,11 +7,13 @@ namespace bs
 {
 	CLeapHandModelBase::CLeapHandModelBase()
 	{
+		mNotifyFlags = TCF_Parent;
 	}
 
 	CLeapHandModelBase::CLeapHandModelBase(const HSceneObject &parent)
 		: Component(parent)
 	{
+		mNotifyFlags = TCF_Parent;
 	}
 
 	void CLeapHandModelBase::begin()
@@ -30,6 +32,32 @@ namespace bs
 		mIsTracked = false;
 	}
 
+	void CLeapHandModelBase::setJointWorldPosition(const HSceneObject& joint, const Vector3& position)
+	{
+		if (mJointWriter != NULL)
+			mJointWriter->setWorldPosition(joint, position);
+		else
+			joint->setWorldPosition(position);
+	}
+
+	void CLeapHandModelBase::refreshRig()
+	{
+		if (!mRig.needsBind())
+			return;
+
+		mRig.clear();
+		onBindRig();
+		mRig.bind(SO());
+	}
+
+	void CLeapHandModelBase::onTransformChanged(TransformChangedFlags flags)
+	{
+		// Reparenting is the only hierarchy change components are notified of. Joints removed from below the model are
+		// caught by the rig itself, once destroyed.
+		if ((flags & TCF_Parent) != 0)
+			mRig.invalidate();
+	}
+
 	RTTITypeBase* CLeapHandModelBase::getRTTIStatic()
 	{
 		return CLeapHandModelBaseRTTI::instance();
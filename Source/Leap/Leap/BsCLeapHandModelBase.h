@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Leap/BsLeapFrame.h"
+#include "Leap/BsLeapJointWriter.h"
+#include "Leap/BsLeapRigBinding.h"
 #include "Scene/BsComponent.h"
 
 namespace bs
@@ -63,9 +65,39 @@ namespace bs
 		 */
 		virtual void setLeapHand(const LeapHand* hand) = 0;
 
+		/**
+		 * Sets the writer batching the joint positions set by the model, or null to set them immediately. For internal
+		 * use.
+		 */
+		virtual void _setJointWriter(LeapJointWriter* writer) { mJointWriter = writer; }
+
 		Event<void()> onBegin;
 		Event<void()> onFinish;
 
+	protected:
+		/** Sets the world position of a joint of the model, through the joint writer if the model has one. */
+		void setJointWorldPosition(const HSceneObject& joint, const Vector3& position);
+
+		/**
+		 * Adds the joints driven by the model to mRig. Called whenever the rig needs to be resolved again, so joints
+		 * assigned directly are picked up even if they were reassigned since.
+		 */
+		virtual void onBindRig() { }
+
+		/**
+		 * Resolves mRig if it was never resolved or if the hierarchy changed since. Only checks the joints otherwise, so
+		 * it can be called every frame.
+		 */
+		void refreshRig();
+
+		/** @copydoc Component::onTransformChanged */
+		void onTransformChanged(TransformChangedFlags flags) override;
+
+		/** Scene objects driven by the model, see onBindRig(). */
+		LeapRigBinding mRig;
+
+		LeapJointWriter* mJointWriter = NULL;
+
 	private:
 		bool mIsTracked = false;
 
@@ -13,36 +13,45 @@ namespace bs
 {
 	HLeapHandModelBase CLeapHandModelManager::ModelGroup::tryGetModel(LeapModelKind kind, eLeapHandType chirality)
 	{
-		for (auto it = mModelList.begin(); it != mModelList.end(); ++it)
-		{
-			HLeapHandModelBase model = *it;
-			if (model->getKind() == kind && model->getChirality() == chirality)
-			{
-				mModelList.erase(it);
-				mModelsCheckedOut.push_back(model);
-				return model;
-			}
-		}
-		return HLeapHandModelBase();
+		Vector<HLeapHandModelBase>& freeModels = mFreeModels[getModelSlot(kind, chirality)];
+		if (freeModels.empty())
+			return HLeapHandModelBase();
+
+		HLeapHandModelBase model = freeModels.back();
+		freeModels.pop_back();
+
+		ModelEntry& entry = mHandModelManager->mModels.at(model.get());
+		entry.mCheckedOutIdx = (UINT32)mModelsCheckedOut.size();
+		mModelsCheckedOut.push_back(model);
+		return model;
 	}
 
 	void CLeapHandModelManager::ModelGroup::returnToGroup(HLeapHandModelBase model)
 	{
-		auto iterFind = std::find(mModelsCheckedOut.begin(), mModelsCheckedOut.end(), model);
-		mModelsCheckedOut.erase(iterFind);
-		mModelList.push_back(model);
-		mHandModelManager->mModelToHandRepMapping.erase(model.get());
+		ModelEntry& entry = mHandModelManager->mModels.at(model.get());
+
+		// Swap with the last checked out model, which takes over the index of the returned one
+		HLeapHandModelBase lastModel = mModelsCheckedOut.back();
+		mModelsCheckedOut[entry.mCheckedOutIdx] = lastModel;
+		mHandModelManager->mModels.at(lastModel.get()).mCheckedOutIdx = entry.mCheckedOutIdx;
+		mModelsCheckedOut.pop_back();
+
+		entry.mCheckedOutIdx = (UINT32)-1;
+		entry.mHandRep = NULL;
+		mFreeModels[getModelSlot(model->getKind(), model->getChirality())].push_back(model);
 	}
 
 	CLeapHandModelManager::CLeapHandModelManager()
 	{
 		setName("LeapHandModelManager");
+		mActiveHandReps.reserve(mRepPool.getCapacity());
 	}
 
 	CLeapHandModelManager::CLeapHandModelManager(const HSceneObject &parent)
 		: Component(parent)
 	{
 		setName("LeapHandModelManager");
+		mActiveHandReps.reserve(mRepPool.getCapacity());
 	}
 
 	void CLeapHandModelManager::setLeapProvider(HLeapServiceProvider provider)
@@ -57,41 +66,41 @@ namespace bs
 
 		if (mProvider != NULL)
 		{
-			mOnFixedFrameConn = mProvider->onFixedFrame.connect(
-				std::bind(&CLeapHandModelManager::onFixedFrame, this, _1));
-			mOnUpdateFrameConn = mProvider->onUpdateFrame.connect(
-				std::bind(&CLeapHandModelManager::onUpdateFrame, this, _1));
+			mOnFixedFrameConn = mProvider->onFixedFrameConnect(
+				std::bind(&CLeapHandModelManager::onFixedFrame, this, _1), "LeapHandModelManager::onFixedFrame",
+				getInstanceId());
+			mOnUpdateFrameConn = mProvider->onUpdateFrameConnect(
+				std::bind(&CLeapHandModelManager::onUpdateFrame, this, _1), "LeapHandModelManager::onUpdateFrame",
+				getInstanceId());
 		}
 	}
 
 	void CLeapHandModelManager::returnToPool(HLeapHandModelBase model)
 	{
-		ModelGroup *modelGroup = mModelGroupMapping.at(model.get());
-		// First see if there is another active Representation that can use this
-		for (int i = 0; i < mActiveHandReps.size(); i++)
+		ModelEntry& entry = mModels.at(model.get());
+		ModelGroup* modelGroup = entry.mGroup;
+
+		// First see if there is another active Representation waiting for a model like this one
+		if (modelGroup->mIsEnabled)
 		{
-			LeapHandRepresentation* rep = mActiveHandReps[i];
-			if (rep->getChirality() == model->getChirality() && rep->getKind() == model->getKind())
+			UINT32 slot = getModelSlot(model->getKind(), model->getChirality());
+			Vector<LeapHandRepHandle>& waitingReps = modelGroup->mWaitingReps[slot];
+			UINT32& head = modelGroup->mWaitingRepsHead[slot];
+
+			while (head < (UINT32)waitingReps.size())
 			{
-				bool modelFromGroupFound = false;
-				// Represention does not contain a model from modelGroup
-				for (int j = 0; j < modelGroup->mModelsCheckedOut.size(); j++)
-				{
-					HLeapHandModelBase modelToCompare = modelGroup->mModelsCheckedOut[j];
-					for (int k = 0; k < rep->mHandModels.size(); k++)
-					{
-						if (rep->mHandModels[k] == modelToCompare)
-							modelFromGroupFound = true;
-					}
-				}
-				if (!modelFromGroupFound)
+				LeapHandRepresentation* rep = mRepPool.get(waitingReps[head]);
+				head++;
+
+				if (rep != NULL)
 				{
 					rep->registerModel(model);
-					mModelToHandRepMapping[model.get()] = rep;
+					entry.mHandRep = rep;
 					return;
 				}
 			}
 		}
+
 		// Otherwise return to pool
 		modelGroup->returnToGroup(model);
 	}
@@ -99,197 +108,259 @@ namespace bs
 	/** Updates the graphics HandRepresentations. */
 	void CLeapHandModelManager::onUpdateFrame(const LeapFrame* frame)
 	{
+		// Take the provider's snapshot rather than the raw frame, so the representations can hold on to it
 		if (frame != NULL && mGraphicsEnabled)
-			_updateHandRepresentations(mGraphicsHandReps, LeapModelKind::Graphics, frame);
+			_updateHandRepresentations(mGraphicsHandReps, LeapModelKind::Graphics, mProvider->getCurrentFrame());
 	}
 
 	/** Updates the physics HandRepresentations. */
 	void CLeapHandModelManager::onFixedFrame(const LeapFrame* frame)
 	{
 		if (frame != NULL && mPhysicsEnabled)
-			_updateHandRepresentations(mPhysicsHandReps, LeapModelKind::Physics, frame);
+			_updateHandRepresentations(mPhysicsHandReps, LeapModelKind::Physics, mProvider->getCurrentFixedFrame());
 	}
 
-	void CLeapHandModelManager::_updateHandRepresentations(Map<UINT32, LeapHandRepresentation* > &handReps,
-		const LeapModelKind modelType, const LeapFrame* frame)
+	void CLeapHandModelManager::_updateHandRepresentations(HandRepTable& handReps, const LeapModelKind modelType,
+		const LeapFrameRef& frame)
 	{
+		if (frame.get() == NULL)
+			return;
+
+		Vector<HandRepSlot>& slots = handReps.mSlots;
+		UINT32 generation = ++handReps.mGeneration;
+
+		// Hands of a frame have distinct ids, so slots added for new hands never need to be searched
+		UINT32 numExistingSlots = (UINT32)slots.size();
 		for (UINT32 i = 0; i < frame->mNumberOfHands; i++)
 		{
 			const LeapHand* curHand = &frame->mHands[i];
-			LeapHandRepresentation* rep;
-			auto it = handReps.find(curHand->mId);
-			if (it == handReps.end())
-			{
-				rep = _createHandRepresentation(curHand, modelType);
-				handReps[curHand->mId] = rep;
-			}
-			else
+
+			UINT32 slotIdx = 0;
+			while (slotIdx < numExistingSlots && slots[slotIdx].mHandId != curHand->mId)
+				slotIdx++;
+
+			if (slotIdx == numExistingSlots)
 			{
-				rep = it->second;
+				HandRepSlot slot;
+				slot.mHandId = curHand->mId;
+
+				LeapHandRepresentation* newRep = _createHandRepresentation(frame, i, modelType);
+				if (newRep != NULL)
+					slot.mRep = mRepPool.getHandle(newRep);
+
+				slotIdx = (UINT32)slots.size();
+				slots.push_back(slot);
 			}
+
+			slots[slotIdx].mGeneration = generation;
+
+			LeapHandRepresentation* rep = mRepPool.get(slots[slotIdx].mRep);
 			if (rep != NULL)
-			{
-				rep->mIsMarked = true;
-				rep->update(curHand);
-			}
+				rep->update(frame, i);
 		}
 
-		/** Mark-and-sweep to finish unused HandRepresentations */
-		LeapHandRepresentation *toBeDeleted = NULL;
-		for (auto it : handReps)
+		// Sweep in a single pass, moving live slots to the front. Every representation whose hand went away is informed
+		// that it will no longer be given any hand updates.
+		UINT32 numLiveSlots = 0;
+		for (UINT32 i = 0; i < (UINT32)slots.size(); i++)
 		{
-			LeapHandRepresentation *rep = it.second;
-			if (rep->mIsMarked)
-			{
-				rep->mIsMarked = false;
-			}
-			else
+			if (slots[i].mGeneration == generation)
 			{
-				// Initialize toBeDeleted with a value to be deleted
-				// Debug.Log("Finishing");
-				toBeDeleted = rep;
+				slots[numLiveSlots++] = slots[i];
+				continue;
 			}
+
+			LeapHandRepresentation* rep = mRepPool.get(slots[i].mRep);
+			if (rep != NULL)
+				rep->finish();
 		}
-		// Inform the representation that we will no longer be giving it any hand updates because the corresponding 
-		// hand has gone away
-		if (toBeDeleted != NULL)
-		{
-			auto it = handReps.find(toBeDeleted->getHandId());
-			handReps.erase(it);
-			toBeDeleted->finish();
-		}
+
+		slots.resize(numLiveSlots);
+
+		// Every model of this kind was updated, their joints are moved together
+		mJointWriters[(UINT32)modelType].commit();
 	}
 
-	void CLeapHandModelManager::addNewGroup(String name, HLeapHandModelBase leftModel, HLeapHandModelBase rightModel)
+	UINT32 CLeapHandModelManager::addNewGroup(String name, HLeapHandModelBase leftModel,
+		HLeapHandModelBase rightModel)
 	{
+		if (mGroupIds.find(name) != mGroupIds.end())
+		{
+			LOGWRN("A group with that name already exists in the groupPool");
+			return INVALID_GROUP_ID;
+		}
+
 		ModelGroup* group = new ModelGroup;
 		group->mGroupName = name;
+		group->mGroupId = (UINT32)mGroupPool.size();
 		group->mLeftModel = leftModel;
 		group->mRightModel = rightModel;
 		mGroupPool.push_back(group);
+		mGroupIds[name] = group->mGroupId;
 
 		_initializeGroup(group);
+		return group->mGroupId;
 	}
 
-	void CLeapHandModelManager::removeGroup(String name)
+	UINT32 CLeapHandModelManager::getGroupId(const String& name) const
 	{
-		auto itFind = std::find_if(mGroupPool.begin(), mGroupPool.end(), [&](auto x) {
-			return x->mGroupName == name;
-		});
+		auto itFind = mGroupIds.find(name);
+		if (itFind == mGroupIds.end())
+			return INVALID_GROUP_ID;
 
-		if (itFind != mGroupPool.end())
-			mGroupPool.erase(itFind);
+		return itFind->second;
 	}
 
-	void CLeapHandModelManager::enableGroup(String name)
+	void CLeapHandModelManager::removeGroup(String name)
 	{
-		auto itFind = std::find_if(mGroupPool.begin(), mGroupPool.end(), [&](auto x) {
-			return x->mGroupName == name;
-		});
+		removeGroup(getGroupId(name));
+	}
 
-		if (itFind != mGroupPool.end())
-		{
-			ModelGroup* group = *itFind;
-			for (int hp = 0; hp < mActiveHandReps.size(); hp++)
-			{
-				LeapHandRepresentation* handRep = mActiveHandReps[hp];
-				HLeapHandModelBase model = group->tryGetModel(handRep->getKind(), handRep->getChirality());
-				if (model != NULL)
-				{
-					handRep->registerModel(model);
-					mModelToHandRepMapping[model.get()] = handRep;
-				}
-			}
-			group->mIsEnabled = true;
-		}
-		else
+	void CLeapHandModelManager::removeGroup(UINT32 groupId)
+	{
+		ModelGroup* group = _findGroup(groupId);
+		if (group == NULL)
+			return;
+
+		disableGroup(groupId);
+
+		for (auto& freeModels : group->mFreeModels)
 		{
-			LOGWRN("A group matching that name does not exisit in the groupPool");
+			for (auto& model : freeModels)
+				mModels.erase(model.get());
 		}
+
+		mGroupIds.erase(group->mGroupName);
+		mGroupPool[groupId] = NULL;
+		delete group;
+	}
+
+	void CLeapHandModelManager::enableGroup(String name)
+	{
+		enableGroup(getGroupId(name));
+	}
+
+	void CLeapHandModelManager::enableGroup(UINT32 groupId)
+	{
+		ModelGroup* group = _findGroup(groupId);
+		if (group == NULL || group->mIsEnabled)
+			return;
+
+		group->mIsEnabled = true;
+		for (auto& handRep : mActiveHandReps)
+			_checkOutModel(group, handRep);
+
+		// Newly registered models were updated outside of the frame updates
+		for (auto& writer : mJointWriters)
+			writer.commit();
 	}
 
 	void CLeapHandModelManager::disableGroup(String name)
 	{
-		auto itFind = std::find_if(mGroupPool.begin(), mGroupPool.end(), [&](auto x) {
-			return x->mGroupName == name;
-		});
+		disableGroup(getGroupId(name));
+	}
+
+	void CLeapHandModelManager::disableGroup(UINT32 groupId)
+	{
+		ModelGroup* group = _findGroup(groupId);
+		if (group == NULL)
+			return;
 
-		if (itFind != mGroupPool.end())
+		// Returning a model moves the last checked out one in its place
+		while (!group->mModelsCheckedOut.empty())
 		{
-			ModelGroup* group = *itFind;
-			for (int m = 0; m < group->mModelsCheckedOut.size(); m++)
-			{
-				HLeapHandModelBase model = group->mModelsCheckedOut[m];
-				auto it = mModelToHandRepMapping.find(model.get());
-				if (it != mModelToHandRepMapping.end())
-				{
-					LeapHandRepresentation* handRep = it->second;
-					handRep->removeModel(model);
-					group->returnToGroup(model);
-					m--;
-				}
-			}
-			group->mIsEnabled = false;
+			HLeapHandModelBase model = group->mModelsCheckedOut.back();
+
+			LeapHandRepresentation* handRep = mModels.at(model.get()).mHandRep;
+			if (handRep != NULL)
+				handRep->removeModel(model);
+
+			group->returnToGroup(model);
 		}
-		else
+
+		for (UINT32 i = 0; i < NUM_MODEL_SLOTS; i++)
 		{
-			LOGWRN("A group matching that name does not exisit in the groupPool");
+			group->mWaitingReps[i].clear();
+			group->mWaitingRepsHead[i] = 0;
 		}
+
+		group->mIsEnabled = false;
 	}
 
 	void CLeapHandModelManager::toggleGroup(String name)
 	{
-		auto itFind = std::find_if(mGroupPool.begin(), mGroupPool.end(), [&](auto x) {
-			return x->mGroupName == name;
-		});
+		toggleGroup(getGroupId(name));
+	}
 
-		if (itFind != mGroupPool.end())
-		{
-			ModelGroup* group = *itFind;
-			if (group->mIsEnabled == true)
-			{
-				disableGroup(name);
-				group->mIsEnabled = false;
-			}
-			else
-			{
-				enableGroup(name);
-				group->mIsEnabled = true;
-			}
-		}
+	void CLeapHandModelManager::toggleGroup(UINT32 groupId)
+	{
+		ModelGroup* group = _findGroup(groupId);
+		if (group == NULL)
+			return;
+
+		if (group->mIsEnabled)
+			disableGroup(groupId);
 		else
-		{
-			LOGWRN("A group matching that name does not exisit in the groupPool");
-		}
+			enableGroup(groupId);
 	}
 
-	LeapHandRepresentation* CLeapHandModelManager::_createHandRepresentation(const LeapHand* hand, const LeapModelKind kind)
+	LeapHandRepresentation* CLeapHandModelManager::_createHandRepresentation(const LeapFrameRef& frame, UINT32 handIndex,
+		const LeapModelKind kind)
 	{
-		LeapHandRepresentation* handRep = new LeapHandRepresentation(this, hand, kind);
+		LeapHandRepresentation* handRep = mRepPool.get(mRepPool.acquire());
+		if (handRep == NULL)
+		{
+			LOGWRN("Out of hand representations, the hand will not be represented. In use: " +
+				toString(mRepPool.getNumLive()));
+			return NULL;
+		}
+
+		handRep->initialize(this, frame, handIndex, kind);
 		for (ModelGroup* group : mGroupPool)
 		{
-			if (group->mIsEnabled)
-			{
-				HLeapHandModelBase model = group->tryGetModel(kind, hand->mType);
-				if (model != NULL)
-				{
-					handRep->registerModel(model);
-					auto it = mModelToHandRepMapping.find(model.get());
-					if (it == mModelToHandRepMapping.end())
-					{
-						mModelToHandRepMapping[model.get()] = handRep;
-					}
-				}
-			}
+			if (group != NULL && group->mIsEnabled)
+				_checkOutModel(group, handRep);
 		}
 		mActiveHandReps.push_back(handRep);
 		return handRep;
 	}
 
+	void CLeapHandModelManager::_checkOutModel(ModelGroup* group, LeapHandRepresentation* handRep)
+	{
+		HLeapHandModelBase model = group->tryGetModel(handRep->getKind(), handRep->getChirality());
+		if (model != NULL)
+		{
+			handRep->registerModel(model);
+			mModels.at(model.get()).mHandRep = handRep;
+		}
+		else
+		{
+			UINT32 slot = getModelSlot(handRep->getKind(), handRep->getChirality());
+			if (group->mNumModels[slot] == 0)
+				return;
+
+			// Drops the representations already served or finished while waiting, so the line never holds more than the
+			// live ones. Only removes entries, the order of the rest is kept.
+			Vector<LeapHandRepHandle>& waitingReps = group->mWaitingReps[slot];
+			UINT32& head = group->mWaitingRepsHead[slot];
+
+			waitingReps.erase(waitingReps.begin(), waitingReps.begin() + head);
+			waitingReps.erase(std::remove_if(waitingReps.begin(), waitingReps.end(),
+				[this](const LeapHandRepHandle& handle) { return mRepPool.get(handle) == NULL; }), waitingReps.end());
+			head = 0;
+
+			waitingReps.push_back(mRepPool.getHandle(handRep));
+		}
+	}
+
 	void CLeapHandModelManager::removeHandRepresentation(LeapHandRepresentation *handRepresentation)
 	{
 		auto it = std::find(mActiveHandReps.begin(), mActiveHandReps.end(), handRepresentation);
+		if (it == mActiveHandReps.end())
+			return;
+
 		mActiveHandReps.erase(it);
+		mRepPool.release(handRepresentation);
 	}
 
 	void CLeapHandModelManager::_initializeProvider()
@@ -312,12 +383,10 @@ namespace bs
 	void CLeapHandModelManager::_initializeGroup(ModelGroup* group)
 	{
 		// Prevent the ModelGroup be initialized by multiple times
-		auto itFind = std::find_if(mModelGroupMapping.begin(), mModelGroupMapping.end(),
-			[&](auto x) { return x.second == group; });
-
-		if (itFind != mModelGroupMapping.end())
+		if (group->mIsInitialized)
 			return;
 
+		group->mIsInitialized = true;
 		group->mHandModelManager = this;
 
 		HLeapHandModelBase leftModel;
@@ -333,10 +402,7 @@ namespace bs
 			leftModel = group->mLeftModel;
 		}
 		if (leftModel != NULL)
-		{
-			group->mModelList.push_back(leftModel);
-			mModelGroupMapping[leftModel.get()] = group;
-		}
+			_registerModel(group, leftModel);
 
 		if (group->mIsRightToBeSpawned)
 		{
@@ -349,10 +415,29 @@ namespace bs
 			rightModel = group->mRightModel;
 		}
 		if (rightModel != NULL)
+			_registerModel(group, rightModel);
+	}
+
+	CLeapHandModelManager::ModelGroup* CLeapHandModelManager::_findGroup(UINT32 groupId) const
+	{
+		if (groupId >= mGroupPool.size() || mGroupPool[groupId] == NULL)
 		{
-			group->mModelList.push_back(rightModel);
-			mModelGroupMapping[rightModel.get()] = group;
+			LOGWRN("A group matching that name does not exisit in the groupPool");
+			return NULL;
 		}
+
+		return mGroupPool[groupId];
+	}
+
+	void CLeapHandModelManager::_registerModel(ModelGroup* group, HLeapHandModelBase model)
+	{
+		ModelEntry entry;
+		entry.mGroup = group;
+		mModels[model.get()] = entry;
+
+		UINT32 slot = getModelSlot(model->getKind(), model->getChirality());
+		group->mFreeModels[slot].push_back(model);
+		group->mNumModels[slot]++;
 	}
 
 	void CLeapHandModelManager::onDisabled()
@@ -369,10 +454,17 @@ namespace bs
 			return;
 
 		for (ModelGroup* group : mGroupPool)
-			_initializeGroup(group);
+		{
+			if (group != NULL)
+				_initializeGroup(group);
+		}
 
-		mOnFixedFrameConn = mProvider->onFixedFrame.connect(std::bind(&CLeapHandModelManager::onFixedFrame, this, _1));
-		mOnUpdateFrameConn = mProvider->onUpdateFrame.connect(std::bind(&CLeapHandModelManager::onUpdateFrame, this, _1));
+		mOnFixedFrameConn = mProvider->onFixedFrameConnect(
+			std::bind(&CLeapHandModelManager::onFixedFrame, this, _1), "LeapHandModelManager::onFixedFrame",
+			getInstanceId());
+		mOnUpdateFrameConn = mProvider->onUpdateFrameConnect(
+			std::bind(&CLeapHandModelManager::onUpdateFrame, this, _1), "LeapHandModelManager::onUpdateFrame",
+			getInstanceId());
 	}
 
 	RTTITypeBase* CLeapHandModelManager::getRTTIStatic()
@@ -5,6 +5,8 @@
 #include "Leap/BsCLeapHandModel.h"
 #include "Leap/BsCLeapServiceProvider.h"
 #include "Leap/BsLeapFrame.h"
+#include "Leap/BsLeapHandRepresentationPool.h"
+#include "Leap/BsLeapJointWriter.h"
 #include "Scene/BsComponent.h"
 
 namespace bs
@@ -25,10 +27,24 @@ namespace bs
 	class CLeapHandModelManager : public Component
 	{
 	public:
+		/** Number of combinations of model kind and chirality. */
+		static constexpr UINT32 NUM_MODEL_SLOTS = 4;
+
+		/** Returns the index of a combination of model kind and chirality, in [0, NUM_MODEL_SLOTS). */
+		static UINT32 getModelSlot(LeapModelKind kind, eLeapHandType chirality)
+		{
+			return (UINT32)kind * 2 + (chirality == eLeapHandType_Right ? 1 : 0);
+		}
+
 		/**
 		 * ModelGroup contains a left/right pair of LeapHandModelBases
-		 * @param mModelList The LeapHandModelBases available for use by LeapHandRepresentations
+		 * @param mFreeModels The LeapHandModelBases available for use by LeapHandRepresentations, per model slot
 		 * @param mModelsCheckedOut The HandModelBases currently in use by active HandRepresentations
+		 * @param mWaitingReps HandRepresentations that found no model available in their slot, first in line for the
+		 * next one returned, in the order they started waiting. Representations finished since are skipped once their
+		 * turn comes.
+		 * @param mWaitingRepsHead Position of the representation first in line in mWaitingReps, per model slot. Served
+		 * entries before it are only dropped when a representation joins the line.
 		 * @param mIsEnabled determines whether the ModelGroup is active at app Start(), though ModelGroup's are controlled
 		 * with the EnableGroup & DisableGroup methods.
 		 */
@@ -37,26 +53,73 @@ namespace bs
 		public:
 			String mGroupName;
 
+			/** Interned ID of the group name, which is also the index of the group in the manager. */
+			UINT32 mGroupId = 0;
+
 			HLeapHandModelBase mLeftModel;
 			HLeapHandModelBase mRightModel;
 			bool mIsLeftToBeSpawned = false;
 			bool mIsRightToBeSpawned = false;
 
-			Vector<HLeapHandModelBase> mModelList;
+			Vector<HLeapHandModelBase> mFreeModels[NUM_MODEL_SLOTS];
 			Vector<HLeapHandModelBase> mModelsCheckedOut;
+			Vector<LeapHandRepHandle> mWaitingReps[NUM_MODEL_SLOTS];
+			UINT32 mWaitingRepsHead[NUM_MODEL_SLOTS] = { };
+
+			/** Number of models of the group in every model slot, checked out or not. */
+			UINT32 mNumModels[NUM_MODEL_SLOTS] = { };
 
 			bool mIsEnabled = true;
+			bool mIsInitialized = false;
 			CLeapHandModelManager* mHandModelManager = NULL;
 
 			/*
-			 * Looks for suitable HandModelBase is the ModelGroup's modelList, if found, it is added to modelsCheckedOut. 
-			 * If not, one can be cloned.
+			 * Takes a HandModelBase of the requested kind and chirality from the free models, if any, and adds it to
+			 * modelsCheckedOut.
 			 */
 			HLeapHandModelBase tryGetModel(LeapModelKind kind, eLeapHandType chirality);
 
+			/** Moves a checked out HandModelBase back to the free models. */
 			void returnToGroup(HLeapHandModelBase model);
 		};
 
+		/** Registry entry of a LeapHandModelBase owned by a ModelGroup. */
+		struct ModelEntry
+		{
+			ModelGroup* mGroup = NULL;
+
+			/** Index of the model in the mModelsCheckedOut list of its group, while checked out. */
+			UINT32 mCheckedOutIdx = (UINT32)-1;
+
+			/** Representation the model is registered to, while checked out. */
+			LeapHandRepresentation* mHandRep = NULL;
+		};
+
+		/** Slot of a LeapHandRepresentation in a HandRepTable. */
+		struct HandRepSlot
+		{
+			UINT32 mHandId = 0;
+
+			/** Generation of the last update the hand was present in. */
+			UINT32 mGeneration = 0;
+
+			/** Unset if no representation could be created for the hand. */
+			LeapHandRepHandle mRep;
+		};
+
+		/**
+		 * Flat table of the LeapHandRepresentations of one kind of model, with one slot per tracked hand. Frames only hold
+		 * a few hands, so hands are matched to their slot with a scan over a handful of contiguous slots. Its storage only
+		 * grows when more hands are tracked at once than ever before.
+		 */
+		struct HandRepTable
+		{
+			Vector<HandRepSlot> mSlots;
+
+			/** Incremented by every update. Slots not stamped with the current generation lost their hand. */
+			UINT32 mGeneration = 0;
+		};
+
 	public:
 		/** Construct CLeapHandModelManager. */
 		CLeapHandModelManager(const HSceneObject &parent);
@@ -69,12 +132,33 @@ namespace bs
 
 		void returnToPool(HLeapHandModelBase model);
 
+		/** Removes a finished LeapHandRepresentation from the active ones and returns it to the pool. */
 		void removeHandRepresentation(LeapHandRepresentation *handRepresentation);
 
-		void addNewGroup(String name, HLeapHandModelBase leftModel, HLeapHandModelBase rightModel);
+		/**
+		 * Returns the writer batching the joint positions set by the models of @p kind. Committed once all of them are
+		 * updated. For internal use.
+		 */
+		LeapJointWriter* _getJointWriter(LeapModelKind kind) { return &mJointWriters[(UINT32)kind]; }
+
+		/** Returns the pool the LeapHandRepresentations are taken from, whose counters can be monitored. */
+		const LeapHandRepresentationPool& getRepresentationPool() const { return mRepPool; }
 
+		/**
+		 * Adds a group of models and returns its ID, which can be used instead of its name to refer to it. Names must be
+		 * unique, adding a group under a name already in use fails and returns INVALID_GROUP_ID.
+		 */
+		UINT32 addNewGroup(String name, HLeapHandModelBase leftModel, HLeapHandModelBase rightModel);
+
+		/** Returns the ID of the group with the provided name, or INVALID_GROUP_ID if there is none. */
+		UINT32 getGroupId(const String& name) const;
+
+		/** Removes a group, taking its models away from the HandRepresentations first. */
 		void removeGroup(String name);
 
+		/** @copydoc removeGroup(String) */
+		void removeGroup(UINT32 groupId);
+
 		// T GetHandModel<T>(int handId) where T : HandModelBase {
 		//  foreach (ModelGroup group in mGroupPool) {
 		//    foreach (HandModelBase handModel in group.modelsCheckedOut) {
@@ -94,6 +178,9 @@ namespace bs
 		*/
 		void enableGroup(String name);
 
+		/** @copydoc enableGroup(String) */
+		void enableGroup(UINT32 groupId);
+
 		/**
 		* DisableGroup finds and removes the ModelGroup's HandModelBases from their HandRepresentations, returns them
 		* to their ModelGroup and sets the groups IsEnabled to false.
@@ -101,8 +188,17 @@ namespace bs
 		*/
 		void disableGroup(String name);
 
+		/** @copydoc disableGroup(String) */
+		void disableGroup(UINT32 groupId);
+
 		void toggleGroup(String name);
 
+		/** @copydoc toggleGroup(String) */
+		void toggleGroup(UINT32 groupId);
+
+		/** ID never returned for a group. */
+		static constexpr UINT32 INVALID_GROUP_ID = (UINT32)-1;
+
 	protected:
 		/** Updates the graphics HandRepresentations. */
 		virtual void onUpdateFrame(const LeapFrame* frame);
@@ -111,45 +207,65 @@ namespace bs
 		virtual void onFixedFrame(const LeapFrame* frame);
 
 		/**
-		* Receives a LeapHand and combines that with a LeapHandModelBase to create a LeapHandRepresentation.
-		* @param hand The LeapHand data to drive a LeapHandModelBase
+		* Receives a LeapHand and combines that with a LeapHandModelBase to create a LeapHandRepresentation. Returns null
+		* if the pool of representations is exhausted.
+		* @param frame The frame holding the LeapHand data to drive a LeapHandModelBase
+		* @param handIndex Index of the LeapHand in the frame
 		* @param modelType Filters for a type of hand model, for example, physics or graphics hands.
 		*/
-		LeapHandRepresentation *_createHandRepresentation(const LeapHand *hand, const LeapModelKind modelType);
+		LeapHandRepresentation *_createHandRepresentation(const LeapFrameRef& frame, UINT32 handIndex,
+			const LeapModelKind modelType);
 
 		/**
-		 * Updates LeapHandRepresentations based in the specified HandRepresentation Dictionary.
+		 * Updates LeapHandRepresentations based in the specified HandRepresentation table.
 		 * Active LeapHandRepresentation instances are updated if the hand they represent is still present in the
-		 * LeapServiceProvider's CurrentFrame. Otherwise, the LeapHandRepresentation is removed.
+		 * LeapServiceProvider's CurrentFrame. Otherwise, the LeapHandRepresentation is removed, in the same update for
+		 * every hand that went away.
 		 * If new LeapHand objects are present in the frame, new HandRepresentations are
-		 * created and added to the dictionary.
-		 * @param handReps = A dictionary of LeapHand ID's with a paired HandRepresentation
+		 * created and added to the table.
+		 * @param handReps Table of the HandRepresentations of @p modelType, paired with the ID of their LeapHand.
 		 * @param modelType Filters for a type of hand model, for example, physics or graphics hands.
-		 * @param frame The LeapFrame containing LeapHand data for each currently tracked hand
+		 * @param frame The LeapFrame containing LeapHand data for each currently tracked hand. The representations keep
+		 *		  a reference to it.
 		 */
-		virtual void _updateHandRepresentations(Map<UINT32, LeapHandRepresentation* > &handReps,
-			const LeapModelKind modelType, const LeapFrame* frame);
+		virtual void _updateHandRepresentations(HandRepTable& handReps, const LeapModelKind modelType,
+			const LeapFrameRef& frame);
 
 	private:
 		void _initializeProvider();
 
 		void _initializeGroup(ModelGroup* group);
 
+		/** Returns the group with the provided ID, logging a warning if there is none. */
+		ModelGroup* _findGroup(UINT32 groupId) const;
+
+		/** Adds a model to the registry and to the free models of @p group. */
+		void _registerModel(ModelGroup* group, HLeapHandModelBase model);
+
+		/**
+		 * Gives @p handRep a model from @p group, or puts it in line for the next model of its kind and chirality returned
+		 * to the group.
+		 */
+		void _checkOutModel(ModelGroup* group, LeapHandRepresentation* handRep);
+
 	public:
 		bool mGraphicsEnabled = true;
 		bool mPhysicsEnabled = true;
 
 	protected:
-		Map<UINT32, LeapHandRepresentation*> mGraphicsHandReps;
-		Map<UINT32, LeapHandRepresentation*> mPhysicsHandReps;
+		HandRepTable mGraphicsHandReps;
+		HandRepTable mPhysicsHandReps;
 
 	private:
+		/** Indexed by group ID. Removed groups leave an empty entry, so that IDs stay valid. */
 		Vector<ModelGroup*> mGroupPool;
+		UnorderedMap<String, UINT32> mGroupIds;
 
+		LeapHandRepresentationPool mRepPool;
+		LeapJointWriter mJointWriters[2];
 		Vector<LeapHandRepresentation*> mActiveHandReps;
 
-		Map<CLeapHandModelBase*, ModelGroup*> mModelGroupMapping;
-		Map<CLeapHandModelBase*, LeapHandRepresentation*> mModelToHandRepMapping;
+		UnorderedMap<CLeapHandModelBase*, ModelEntry> mModels;
 
 		HLeapServiceProvider mProvider;
 
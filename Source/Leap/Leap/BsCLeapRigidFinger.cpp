@@ -56,7 +56,7 @@ namespace bs
 				//else
 				{
 					//mBones[i]->setWorldPosition(getBoneCenter(i));
-					mBones[i]->setWorldPosition(mFinger->mBones[i].mNextJoint);
+					setJointWorldPosition(mBones[i], mFinger->mBones[i].mNextJoint);
 					//mBones[i]->setRotation(getBoneRotation(i));
 				}
 			}
@@ -2,8 +2,6 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 
 #include "BsCLeapRigidHand.h"
-#include "Components/BsCCapsuleCollider.h"
-#include "Components/BsCRigidbody.h"
 #include "Private/RTTI/BsCLeapRigidHandRTTI.h"
 
 namespace bs
@@ -27,17 +25,18 @@ namespace bs
 				mFingers[f]->updateFrame();
 		}
 
+		refreshComponents();
+
 		if (mPalm != NULL)
 		{
-			HRigidbody palmBody = mPalm->getComponent<CRigidbody>();
-			if (palmBody)
+			if (mPalmBody)
 			{
-				palmBody->move(getPalmCenter());
-				//palmBody->rotate(getPalmRotation());
+				mPalmBody->move(getPalmCenter());
+				//mPalmBody->rotate(getPalmRotation());
 			}
 			else
 			{
-				mPalm->setWorldPosition(getPalmCenter());
+				setJointWorldPosition(mPalm, getPalmCenter());
 				//mPalm->setRotation(getPalmRotation());
 			}
 		}
@@ -45,32 +44,45 @@ namespace bs
 		if (mForearm != NULL)
 		{
 			// Set arm dimensions.
-			HCapsuleCollider capsule = mForearm->getComponent<CCapsuleCollider>();
-			if (capsule != NULL)
+			if (mForearmCapsule != NULL)
 			{
 				Vector3 scale = SO()->getTransform().getScale();
 				// Initialization
 				//mForearm->localScale = new Vector3(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
 
 				// Update
-				capsule->setRadius(getArmWidth() * 0.5f);
-				capsule->setHalfHeight((getArmLength() + getArmWidth()) * 0.5f);
+				mForearmCapsule->setRadius(getArmWidth() * 0.5f);
+				mForearmCapsule->setHalfHeight((getArmLength() + getArmWidth()) * 0.5f);
 			}
 
-			HRigidbody forearmBody = mForearm->getComponent<CRigidbody>();
-			if (forearmBody)
+			if (mForearmBody)
 			{
-				forearmBody->move(getArmCenter());
-				//forearmBody->rotate(getArmRotation());
+				mForearmBody->move(getArmCenter());
+				//mForearmBody->rotate(getArmRotation());
 			}
 			else
 			{
-				mForearm->setWorldPosition(getArmCenter());
+				setJointWorldPosition(mForearm, getArmCenter());
 				//mForearm->setRotation(getArmRotation());
 			}
 		}
 	}
 
+	void CLeapRigidHand::refreshComponents()
+	{
+		// The joints are public and can be reassigned or destroyed at any time, comparing the handles catches both
+		if (mComponentsPalm == mPalm && mComponentsForearm == mForearm && mHasComponents)
+			return;
+
+		mComponentsPalm = mPalm;
+		mComponentsForearm = mForearm;
+		mHasComponents = true;
+
+		mPalmBody = mPalm != NULL ? mPalm->getComponent<CRigidbody>() : HRigidbody();
+		mForearmBody = mForearm != NULL ? mForearm->getComponent<CRigidbody>() : HRigidbody();
+		mForearmCapsule = mForearm != NULL ? mForearm->getComponent<CCapsuleCollider>() : HCapsuleCollider();
+	}
+
 	RTTITypeBase* CLeapRigidHand::getRTTIStatic()
 	{
 		return CLeapRigidHandRTTI::instance();
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Leap/BsCLeapSkeletalHand.h"
+#include "Components/BsCCapsuleCollider.h"
+#include "Components/BsCRigidbody.h"
 
 namespace bs
 {
@@ -26,6 +28,19 @@ namespace bs
 		/** @copydoc CLeapHandModelBase::updateFrame */
 		void updateFrame() override;
 
+	protected:
+		/** Looks up the components of the joints again if the joints changed since they were last looked up. */
+		void refreshComponents();
+
+		HRigidbody mPalmBody;
+		HRigidbody mForearmBody;
+		HCapsuleCollider mForearmCapsule;
+
+		/** Joints the components were looked up from. */
+		HSceneObject mComponentsPalm;
+		HSceneObject mComponentsForearm;
+		bool mHasComponents = false;
+
 		/************************************************************************/
 		/* 						COMPONENT OVERRIDES                      		*/
 		/************************************************************************/
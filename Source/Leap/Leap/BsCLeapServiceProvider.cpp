@@ -11,14 +11,64 @@ using namespace std::placeholders;
 /** Converts millimeters to meters. */
 static constexpr double MM_TO_M = 1e-3;
 
-/** Converts nanoseconds to seconds. */
-static constexpr double NS_TO_S = 1e-6;
+/** Converts microseconds to seconds. */
+static constexpr double US_TO_S = 1e-6;
 
-/** Converts seconds to nanoseconds. */
-static constexpr double S_TO_NS = 1e6;
+/** Converts seconds to microseconds. */
+static constexpr double S_TO_US = 1e6;
 
 namespace bs
 {
+	/** Names of the ProfilerCPU samples of every LeapProviderStage. */
+	static const char* STAGE_SAMPLE_NAMES[] =
+	{
+		"LeapProvider.LatencySmoothing",
+		"LeapProvider.UpdateFetch",
+		"LeapProvider.FixedFetch",
+		"LeapProvider.Transform",
+		"LeapProvider.UpdateDispatch",
+		"LeapProvider.FixedDispatch"
+	};
+
+	static_assert(sizeof(STAGE_SAMPLE_NAMES) / sizeof(STAGE_SAMPLE_NAMES[0]) == (UINT32)LeapProviderStage::Count,
+		"Every stage needs a sample name.");
+
+	/** Names of the frame optimization modes, for logging. */
+	static const char* FRAME_OPTIMIZATION_NAMES[] =
+	{
+		"None",
+		"ReuseUpdateForPhysics",
+		"ReusePhysicsForUpdate",
+		"Auto"
+	};
+
+	/** Interval at which automatic frame optimization re-evaluates the mode, in microseconds. */
+	static constexpr UINT64 FRAME_OPTIMIZATION_INTERVAL = 1000000;
+
+	/** Fraction of the current cost another mode must save for automatic frame optimization to switch to it. */
+	static constexpr float FRAME_OPTIMIZATION_COST_MARGIN = 0.2f;
+
+	/**
+	 * Fraction of the maximum frame reuse error a mode must stay under for automatic frame optimization to switch to it.
+	 * Leaving a mode only happens once the maximum itself is exceeded.
+	 */
+	static constexpr float FRAME_OPTIMIZATION_ERROR_MARGIN = 0.8f;
+
+	/** Evaluations in a row a mode must be preferred in, for automatic frame optimization to switch to it. */
+	static constexpr UINT32 FRAME_OPTIMIZATION_NUM_EVALUATIONS = 3;
+
+	namespace
+	{
+		/** Times a stage of the provider, reported to the profiler under the name of the stage. */
+		class StageTiming : public LeapScopedTiming
+		{
+		public:
+			StageTiming(LeapTimingHistogram* histograms, LeapProviderStage stage)
+				: LeapScopedTiming(histograms[(UINT32)stage], STAGE_SAMPLE_NAMES[(UINT32)stage])
+			{ }
+		};
+	}
+
 	CLeapServiceProvider::CLeapServiceProvider()
 	{
 		setName("LeapServiceProvider");
@@ -32,20 +82,49 @@ namespace bs
 		setFlag(ComponentFlag::AlwaysRun, true);
 	}
 
-	LeapFrame* CLeapServiceProvider::getCurrentFrame()
+	LeapFrameRef CLeapServiceProvider::getCurrentFrame()
 	{
-		if (mFrameOptimization == FrameOptimizationReusePhysicsForUpdate)
-			return mTransformedFixedFrame.get();
+		// Transformed on demand, does nothing if the frame was already transformed this cycle
+		if (mActiveFrameOptimization == FrameOptimizationReusePhysicsForUpdate)
+		{
+			_transformFrame(mUntransformedFixedFrame, mTransformedFixedFrame, mFixedFrameSource);
+			return mTransformedFixedFrame;
+		}
 		else
-			return mTransformedUpdateFrame.get();
+		{
+			_transformFrame(mUntransformedUpdateFrame, mTransformedUpdateFrame, mUpdateFrameSource);
+			return mTransformedUpdateFrame;
+		}
 	}
 
-	LeapFrame* CLeapServiceProvider::getCurrentFixedFrame()
+	LeapFrameRef CLeapServiceProvider::getCurrentFixedFrame()
 	{
-		if (mFrameOptimization == FrameOptimizationReuseUpdateForPhysics)
-			return mTransformedUpdateFrame.get();
+		if (mActiveFrameOptimization == FrameOptimizationReuseUpdateForPhysics)
+		{
+			_transformFrame(mUntransformedUpdateFrame, mTransformedUpdateFrame, mUpdateFrameSource);
+			return mTransformedUpdateFrame;
+		}
 		else
-			return mTransformedFixedFrame.get();
+		{
+			_transformFrame(mUntransformedFixedFrame, mTransformedFixedFrame, mFixedFrameSource);
+			return mTransformedFixedFrame;
+		}
+	}
+
+	const LeapFrameView& CLeapServiceProvider::getCurrentFrameView() const
+	{
+		if (mActiveFrameOptimization == FrameOptimizationReusePhysicsForUpdate)
+			return mFixedFrameView;
+		else
+			return mUpdateFrameView;
+	}
+
+	const LeapFrameView& CLeapServiceProvider::getCurrentFixedFrameView() const
+	{
+		if (mActiveFrameOptimization == FrameOptimizationReuseUpdateForPhysics)
+			return mUpdateFrameView;
+		else
+			return mFixedFrameView;
 	}
 
 	bool CLeapServiceProvider::isConnected()
@@ -71,8 +150,12 @@ namespace bs
 
 	void CLeapServiceProvider::retransformFrames()
 	{
-		_transformFrame(mUntransformedUpdateFrame, mTransformedUpdateFrame);
-		_transformFrame(mUntransformedFixedFrame, mTransformedFixedFrame);
+		const Transform& transform = SO()->getTransform();
+		UINT32 transformHash = SO()->getTransformHash();
+		mUpdateFrameView.reset(mUntransformedUpdateFrame.get(), transform, transformHash);
+		mFixedFrameView.reset(mUntransformedFixedFrame.get(), transform, transformHash);
+
+		// Snapshots compare the transform hash whenever they are requested, and are only retransformed then if it changed
 	}
 
 	HEvent CLeapServiceProvider::onDeviceSafeConnect(std::function<void(SPtr<LeapDevice>)> func)
@@ -86,6 +169,82 @@ namespace bs
 		return onDeviceSafe.connect(func);
 	}
 
+	HEvent CLeapServiceProvider::onUpdateFrameConnect(std::function<void(const LeapFrame*)> func, const String& name,
+		UINT64 subscriberId)
+	{
+		return connectTimed(onUpdateFrame, std::move(func), name, subscriberId);
+	}
+
+	HEvent CLeapServiceProvider::onFixedFrameConnect(std::function<void(const LeapFrame*)> func, const String& name,
+		UINT64 subscriberId)
+	{
+		return connectTimed(onFixedFrame, std::move(func), name, subscriberId);
+	}
+
+	HEvent CLeapServiceProvider::onUpdateFrameViewConnect(std::function<void(const LeapFrameView&)> func,
+		const String& name, UINT64 subscriberId)
+	{
+		return connectTimed(onUpdateFrameView, std::move(func), name, subscriberId);
+	}
+
+	HEvent CLeapServiceProvider::onFixedFrameViewConnect(std::function<void(const LeapFrameView&)> func,
+		const String& name, UINT64 subscriberId)
+	{
+		return connectTimed(onFixedFrameView, std::move(func), name, subscriberId);
+	}
+
+	template<class T>
+	HEvent CLeapServiceProvider::connectTimed(Event<void(T)>& event, std::function<void(T)> func, const String& name,
+		UINT64 subscriberId)
+	{
+		// Kept after the subscriber disconnects, so its statistics stay available. Subscribers reconnecting under the same
+		// name and id get their old entry back, so the list only grows with the number of distinct subscribers.
+		auto itFind = std::find_if(mSubscriberTimings.begin(), mSubscriberTimings.end(),
+			[&name, subscriberId](const SPtr<SubscriberTiming>& entry)
+			{
+				return entry->mName == name && entry->mSubscriberId == subscriberId;
+			});
+
+		SPtr<SubscriberTiming> timing;
+		if (itFind != mSubscriberTimings.end())
+			timing = *itFind;
+		else
+		{
+			timing = bs_shared_ptr_new<SubscriberTiming>();
+			timing->mName = name;
+			timing->mSubscriberId = subscriberId;
+			mSubscriberTimings.push_back(timing);
+		}
+
+		return event.connect([func = std::move(func), timing](T value)
+		{
+			LeapScopedTiming scope(timing->mHistogram, timing->mName.c_str());
+			func(value);
+		});
+	}
+
+	LeapProviderTimingStats CLeapServiceProvider::getTimingStats() const
+	{
+		LeapProviderTimingStats output;
+		for (UINT32 i = 0; i < (UINT32)LeapProviderStage::Count; ++i)
+			output.mStages[i] = mStageTimings[i].getStats();
+
+		output.mSubscribers.reserve(mSubscriberTimings.size());
+		for (auto& entry : mSubscriberTimings)
+			output.mSubscribers.push_back({ entry->mName, entry->mSubscriberId, entry->mHistogram.getStats() });
+
+		return output;
+	}
+
+	void CLeapServiceProvider::resetTimingStats()
+	{
+		for (auto& entry : mStageTimings)
+			entry.reset();
+
+		for (auto& entry : mSubscriberTimings)
+			entry->mHistogram.reset();
+	}
+
 	void CLeapServiceProvider::initializeService()
 	{
 		if (mLeap != NULL)
@@ -93,9 +252,18 @@ namespace bs
 
 		mLeap = &gLeapService();
 
+		// Other providers may share the connection, it only stops once all of them are released
+		mLeap->acquireSession();
+
+		// Size the frame buffers up front so that updates don't allocate once running
+		UINT32 maxHands = mLeap->getMaxHands();
+		mUntransformedUpdateFrame.reserveNumberOfHands(maxHands);
+		mUntransformedFixedFrame.reserveNumberOfHands(maxHands);
+		mFramePool.reserveNumberOfHands(maxHands);
+
 		// trigger onDeviceSafe
-		mOnDeviceInitConn = mLeap->onDevice.connect(
-			std::bind(&CLeapServiceProvider::triggerOnDeviceSafe, this, _1));
+		mOnDeviceSafeConn = mLeap->connectDevice(
+			std::bind(&CLeapServiceProvider::triggerOnDeviceSafe, this, _1), LeapDeliveryPolicy::MainThread);
 
 		if (mLeap->isConnected())
 		{
@@ -103,8 +271,8 @@ namespace bs
 		}
 		else
 		{
-			mOnDeviceInitConn = mLeap->onDevice.connect(
-				std::bind(&CLeapServiceProvider::onDeviceInit, this, _1));
+			mOnDeviceInitConn = mLeap->connectDevice(
+				std::bind(&CLeapServiceProvider::onDeviceInit, this, _1), LeapDeliveryPolicy::MainThread);
 		}
 	}
 
@@ -121,64 +289,257 @@ namespace bs
 		if (mLeap == NULL)
 			return;
 
-		if (mLeap->isConnected())
+		// The service outlives this provider while other providers hold a session, its events must not reach it anymore
+		mOnDeviceSafeConn.disconnect();
+		mOnDeviceInitConn.disconnect();
+
+		if (mLeap->isConnected() && mLeap->getNumSessions() == 1)
 			mLeap->clearPolicy(eLeapPolicyFlag_OptimizeHMD);
 
-		mLeap->stopConnection();
+		mLeap->releaseSession();
 		mLeap = NULL;
 	}
 
-	bool CLeapServiceProvider::checkConnectionIntegrity()
+	INT64 CLeapServiceProvider::calculateInterpolationTime(UINT64 time)
 	{
-		if (mLeap->isServiceConnected())
+		INT64 leapTime = mLeap->getClockSync().toLeapTime((INT64)time);
+		return leapTime - (INT64)mLeap->getSmoothedTrackingLatency();
+	}
+
+	INT64 CLeapServiceProvider::calculatePredictionTime(UINT64 time)
+	{
+		INT64 leapTime = mLeap->getClockSync().toLeapTime((INT64)time);
+		return leapTime + (mExtrapolationAmount * 1000);
+	}
+
+	UINT64 CLeapServiceProvider::calculateFixedUpdateTime()
+	{
+		// The engine reports the fixed update time in seconds as a float, which gets coarser than a millisecond after a
+		// few hours. The fixed timeline advances by whole steps though, so it is followed in microseconds and only
+		// resynchronized when the reported time disagrees by more than its own precision, like after skipped updates.
+		float reportedTime = gTime().getLastFixedUpdateTime();
+		double precision = (std::nextafter(reportedTime, std::numeric_limits<float>::max()) - reportedTime) * S_TO_US + 1.0;
+
+		UINT64 step = (UINT64)std::llround(gTime().getFixedUpdateStep() * S_TO_US);
+		UINT64 nextTime = mFixedUpdateTime + step;
+		if (mFixedUpdateTime == 0 || std::abs((double)nextTime - reportedTime * S_TO_US) > precision)
+			mFixedUpdateTime = (UINT64)std::llround(reportedTime * S_TO_US);
+		else
+			mFixedUpdateTime = nextTime;
+
+		return mFixedUpdateTime;
+	}
+
+	void CLeapServiceProvider::handleUpdateFrameEvent()
+	{
+		StageTiming timing(mStageTimings, LeapProviderStage::UpdateDispatch);
+
+		if (!onUpdateFrameView.empty())
+			onUpdateFrameView(getCurrentFrameView());
+
+		// The provider keeps its own reference, so the frame outlives the temporary
+		if (!onUpdateFrame.empty())
+			onUpdateFrame(getCurrentFrame().get());
+	}
+
+	void CLeapServiceProvider::handleFixedFrameEvent()
+	{
+		StageTiming timing(mStageTimings, LeapProviderStage::FixedDispatch);
+
+		if (!onFixedFrameView.empty())
+			onFixedFrameView(getCurrentFixedFrameView());
+
+		if (!onFixedFrame.empty())
+			onFixedFrame(getCurrentFixedFrame().get());
+	}
+
+	bool CLeapServiceProvider::_transformFrame(const LeapFrameAlloc& source, LeapFrameRef& dest,
+		TransformedFrameSource& last)
+	{
+		const LeapFrame* sourceFrame = source.get();
+		if (sourceFrame == NULL)
+			return false;
+
+		// Sources are sampled by timestamp from tracking frames, so the same id and timestamp mean the same hand data
+		UINT32 transformHash = SO()->getTransformHash();
+		if (last.mIsValid && last.mFrameId == sourceFrame->mInfo.frame_id &&
+			last.mTimestamp == sourceFrame->mInfo.timestamp && last.mTransformHash == transformHash)
 		{
-			mFramesSinceServiceConnectionChecked = 0;
-			mNumberOfReconnectionAttempts = 0;
-			return true;
+			return false;
 		}
-		else if (mNumberOfReconnectionAttempts < MAX_RECONNECTION_ATTEMPTS)
+
+		StageTiming timing(mStageTimings, LeapProviderStage::Transform);
+		UINT64 transformStart = gTime().getTimePrecise();
+
+		// Never write into a published snapshot, someone might still be holding it
+		LeapFrameRef snapshot = mFramePool.acquire();
+		LeapFrameAlloc& frame = snapshot._getWritable();
+
+		frame = source;
+		LeapFrameUtility::transform(frame.get(), SO()->getTransform());
+
+		dest = std::move(snapshot);
+
+		last.mIsValid = true;
+		last.mFrameId = sourceFrame->mInfo.frame_id;
+		last.mTimestamp = sourceFrame->mInfo.timestamp;
+		last.mTransformHash = transformHash;
+		addFrameCost(&last == &mFixedFrameSource, gTime().getTimePrecise() - transformStart);
+		return true;
+	}
+
+	void CLeapServiceProvider::updateFrameOptimization()
+	{
+		if (mFrameOptimization != FrameOptimizationAuto)
+		{
+			mActiveFrameOptimization = mFrameOptimization;
+			mOptimizationWindow = FrameOptimizationWindow();
+			return;
+		}
+
+		UINT64 now = gTime().getTimePrecise();
+		FrameOptimizationWindow& window = mOptimizationWindow;
+		if (window.mStart == 0)
+		{
+			window = FrameOptimizationWindow();
+			window.mStart = now;
+			return;
+		}
+
+		window.mNumUpdates++;
+
+		UINT64 elapsed = now - window.mStart;
+		if (elapsed < FRAME_OPTIMIZATION_INTERVAL)
+			return;
+
+		float seconds = (float)(elapsed * US_TO_S);
+		float updateRate = window.mNumUpdates / seconds;
+		float fixedRate = window.mNumFixedUpdates / seconds;
+
+		// Modes reusing frames only compute one of them, the other cost is kept from when it was last measured
+		if (window.mNumUpdateFrames > 0)
+			mUpdateFrameCost = (float)window.mUpdateCost / window.mNumUpdateFrames;
+
+		if (window.mNumFixedFrames > 0)
+			mFixedFrameCost = (float)window.mFixedCost / window.mNumFixedFrames;
+
+		window = FrameOptimizationWindow();
+		window.mStart = now;
+
+		FrameOptimizationMode active = mActiveFrameOptimization;
+		bool isActiveTooInaccurate = estimateFrameOptimizationError(active, updateRate) > mMaxFrameReuseError;
+
+		FrameOptimizationMode best = active;
+		float bestCost = std::numeric_limits<float>::infinity();
+		if (!isActiveTooInaccurate)
+			bestCost = estimateFrameOptimizationCost(active, updateRate, fixedRate) * (1.0f - FRAME_OPTIMIZATION_COST_MARGIN);
+
+		static constexpr FrameOptimizationMode CANDIDATES[] =
 		{
-			mFramesSinceServiceConnectionChecked++;
+			FrameOptimizationNone,
+			FrameOptimizationReuseUpdateForPhysics,
+			FrameOptimizationReusePhysicsForUpdate
+		};
 
-			if (mFramesSinceServiceConnectionChecked > RECONNECTION_INTERVAL)
+		// Not reusing frames has no error, so there is always a candidate when the active mode is too inaccurate
+		for (auto& mode : CANDIDATES)
+		{
+			if (mode == active)
+				continue;
+
+			float error = estimateFrameOptimizationError(mode, updateRate);
+			if (error > mMaxFrameReuseError * FRAME_OPTIMIZATION_ERROR_MARGIN)
+				continue;
+
+			float cost = estimateFrameOptimizationCost(mode, updateRate, fixedRate);
+			if (cost < bestCost)
 			{
-				mFramesSinceServiceConnectionChecked = 0;
-				mNumberOfReconnectionAttempts++;
-
-				String msg = "Leap Service not connected; attempting to reconnect for try " +
-					toString(mNumberOfReconnectionAttempts) + "/" + toString(MAX_RECONNECTION_ATTEMPTS) + "...";
-				LOGWRN(msg);
-				releaseService();
-				initializeService();
+				best = mode;
+				bestCost = cost;
 			}
 		}
-		return false;
+
+		if (best == active)
+		{
+			mNumPendingEvaluations = 0;
+			return;
+		}
+
+		if (best != mPendingFrameOptimization)
+		{
+			mPendingFrameOptimization = best;
+			mNumPendingEvaluations = 0;
+		}
+
+		mNumPendingEvaluations++;
+		if (!isActiveTooInaccurate && mNumPendingEvaluations < FRAME_OPTIMIZATION_NUM_EVALUATIONS)
+			return;
+
+		LOGDBG("Frame optimization switched from " + String(FRAME_OPTIMIZATION_NAMES[active]) + " to " +
+			String(FRAME_OPTIMIZATION_NAMES[best]) + (isActiveTooInaccurate ? " (too inaccurate)" : "") +
+			". Update rate: " + toString(updateRate) + " Hz, fixed update rate: " + toString(fixedRate) +
+			" Hz, update frame cost: " + toString(mUpdateFrameCost) + " us, fixed frame cost: " +
+			toString(mFixedFrameCost) + " us.");
+
+		mActiveFrameOptimization = best;
+		mNumPendingEvaluations = 0;
 	}
 
-	int64_t CLeapServiceProvider::calculateInterpolationTime()
+	float CLeapServiceProvider::estimateFrameOptimizationCost(FrameOptimizationMode mode, float updateRate,
+		float fixedRate) const
 	{
-		if (mLeap != NULL)
-			return mLeap->getNow() - (uint64_t)mSmoothedTrackingLatency.mValue;
-		else
-			return 0;
+		// Until a cost was measured, assume it is the same as the other one
+		float updateCost = mUpdateFrameCost > 0.0f ? mUpdateFrameCost : mFixedFrameCost;
+		float fixedCost = mFixedFrameCost > 0.0f ? mFixedFrameCost : mUpdateFrameCost;
+
+		switch (mode)
+		{
+		case FrameOptimizationReuseUpdateForPhysics:
+			return updateRate * updateCost;
+		case FrameOptimizationReusePhysicsForUpdate:
+			return fixedRate * fixedCost;
+		default:
+			return updateRate * updateCost + fixedRate * fixedCost;
+		}
 	}
 
-	void CLeapServiceProvider::handleUpdateFrameEvent(LeapFrame* frame)
+	float CLeapServiceProvider::estimateFrameOptimizationError(FrameOptimizationMode mode, float updateRate) const
 	{
-		if (!onUpdateFrame.empty())
-			onUpdateFrame(frame);
+		switch (mode)
+		{
+		case FrameOptimizationReuseUpdateForPhysics:
+			// Physics sees the hands of the last update
+			return updateRate > 0.0f ? 1.0f / updateRate : std::numeric_limits<float>::infinity();
+		case FrameOptimizationReusePhysicsForUpdate:
+			// Updates see the hands of the last fixed update, which may be a whole step behind
+			return gTime().getFixedUpdateStep();
+		default:
+			return 0.0f;
+		}
 	}
 
-	void CLeapServiceProvider::handleFixedFrameEvent(LeapFrame* frame)
+	void CLeapServiceProvider::recordFrameCost(bool isFixed, UINT64 cost)
 	{
-		if (!onFixedFrame.empty())
-			onFixedFrame(frame);
+		if (mFrameOptimization != FrameOptimizationAuto)
+			return;
+
+		if (isFixed)
+			mOptimizationWindow.mNumFixedFrames++;
+		else
+			mOptimizationWindow.mNumUpdateFrames++;
+
+		addFrameCost(isFixed, cost);
 	}
 
-	void CLeapServiceProvider::_transformFrame(const LeapFrameAlloc& source, LeapFrameAlloc& dest)
+	void CLeapServiceProvider::addFrameCost(bool isFixed, UINT64 cost)
 	{
-		dest = source;
-		LeapFrameUtility::transform(dest.get(), SO()->getTransform());
+		if (mFrameOptimization != FrameOptimizationAuto)
+			return;
+
+		if (isFixed)
+			mOptimizationWindow.mFixedCost += cost;
+		else
+			mOptimizationWindow.mUpdateCost += cost;
 	}
 
 	void CLeapServiceProvider::onDeviceInit(const LEAP_DEVICE_EVENT* deviceEvent)
@@ -199,103 +560,158 @@ namespace bs
 
 	void CLeapServiceProvider::update()
 	{
-		if (!mLeap->isConnected() || !mLeap->hasFrame())
+		mLeap->dispatchQueuedEvents();
+
+		// Shared by every provider, so they all ask for the same times and can share their frames
 		{
-			checkConnectionIntegrity();
-			return;
+			StageTiming timing(mStageTimings, LeapProviderStage::LatencySmoothing);
+			mLeap->updateClocks();
 		}
 
-		if (mFrameOptimization == FrameOptimizationReusePhysicsForUpdate)
+		updateFrameOptimization();
+
+		// Reconnections are handled by the service, in the background
+		if (!mLeap->isConnected() || !mLeap->hasFrame())
+			return;
+
+		if (mActiveFrameOptimization == FrameOptimizationReusePhysicsForUpdate)
 		{
-			handleUpdateFrameEvent(mTransformedFixedFrame.get());
+			handleUpdateFrameEvent();
 			return;
 		}
 
+		UINT64 fetchStart = gTime().getTimePrecise();
+		bool success;
 		if (mUseInterpolation)
 		{
-			float trackingLatency = (float)(mLeap->getNow() - mLeap->getFrameTimestamp());
-			mSmoothedTrackingLatency.mValue = std::min(mSmoothedTrackingLatency.mValue, 30000.0f);
-			mSmoothedTrackingLatency.update(trackingLatency, gTime().getFrameDelta());
-
-			INT64 interpolationTime = calculateInterpolationTime();
+			UINT64 frameTime = mLeap->getFrameTime();
+			INT64 interpolationTime = calculateInterpolationTime(frameTime);
 			INT64 timestamp = interpolationTime + (mExtrapolationAmount * 1000);
 			INT64 sourceTimestamp = interpolationTime - (mBounceAmount * 1000);
 
-			bool success = mLeap->getInterpolatedFrameFromTime(timestamp, sourceTimestamp, &mUntransformedUpdateFrame);
-			if (!success)
-				return;
-
-			mBsToLeapOffset = timestamp - (uint64_t)(gTime().getTime() * S_TO_NS);
+			// Only the bounce effect needs the service, plain interpolation is done locally from the frame history.
+			// Providers asking for the same time during the same engine frame share a single interpolation.
+			{
+				StageTiming timing(mStageTimings, LeapProviderStage::UpdateFetch);
+
+				if (mUsePrediction)
+				{
+					INT64 predictionTime = calculatePredictionTime(frameTime);
+					success = mLeap->getPredictedFrame(predictionTime, &mUntransformedUpdateFrame, mPredictor);
+				}
+				else if (mBounceAmount == 0)
+				{
+					success = mLeap->getSharedFrameAt(timestamp, gTime().getFrameIdx(), &mUntransformedUpdateFrame,
+						mUpdateInterpolator);
+				}
+				else
+				{
+					success = mLeap->getSharedInterpolatedFrameFromTime(timestamp, sourceTimestamp,
+						gTime().getFrameIdx(), &mUntransformedUpdateFrame);
+				}
+			}
 		}
 		else
 		{
-			*mUntransformedUpdateFrame.get() = mLeap->getFrame();
+			StageTiming timing(mStageTimings, LeapProviderStage::UpdateFetch);
+			success = mLeap->getFrame(&mUntransformedUpdateFrame);
 		}
 
+		recordFrameCost(false, gTime().getTimePrecise() - fetchStart);
+		if (!success)
+			return;
+
 		if (mUntransformedUpdateFrame.get() != NULL)
 		{
-			_transformFrame(mUntransformedUpdateFrame, mTransformedUpdateFrame);
+			mUpdateFrameView.reset(mUntransformedUpdateFrame.get(), SO()->getTransform(), SO()->getTransformHash());
 
-			handleUpdateFrameEvent(mTransformedUpdateFrame.get());
+			handleUpdateFrameEvent();
 		}
 	}
 
 	void CLeapServiceProvider::fixedUpdate()
 	{
+		mOptimizationWindow.mNumFixedUpdates++;
+
 		if (!mLeap->isConnected() || !mLeap->hasFrame())
 			return;
 
-		if (mFrameOptimization == FrameOptimizationReuseUpdateForPhysics)
+		if (mActiveFrameOptimization == FrameOptimizationReuseUpdateForPhysics)
 		{
-			handleFixedFrameEvent(mTransformedUpdateFrame.get());
+			handleFixedFrameEvent();
 			return;
 		}
 
+		UINT64 fetchStart = gTime().getTimePrecise();
+		bool success;
 		if (mUseInterpolation)
 		{
-			uint64_t timestamp;
-			switch (mFrameOptimization)
+			// Fixed updates run before the update of the same frame, the first of them samples the clocks
+			{
+				StageTiming timing(mStageTimings, LeapProviderStage::LatencySmoothing);
+				mLeap->updateClocks();
+			}
+
+			INT64 timestamp = 0;
+			switch (mActiveFrameOptimization)
 			{
 			case FrameOptimizationNone:
 			{
 				// By default we use gCoreApplication().getFixedUpdateStep() to ensure that our hands are on the same
 				// timeline as Update.  We add an extrapolation value to help compensate
 				// for latency.
-				float extrapolatedTime = gTime().getLastFixedUpdateTime() + calculatePhysicsExtrapolation();
-				timestamp = (UINT64)(extrapolatedTime * S_TO_NS) + mBsToLeapOffset;
+				UINT64 extrapolation = (UINT64)std::llround(calculatePhysicsExtrapolation() * S_TO_US);
+				UINT64 extrapolatedTime = calculateFixedUpdateTime() + extrapolation;
+				if (mUsePrediction)
+					timestamp = calculatePredictionTime(extrapolatedTime);
+				else
+					timestamp = calculateInterpolationTime(extrapolatedTime) + (mExtrapolationAmount * 1000);
 			} break;
 			case FrameOptimizationReusePhysicsForUpdate:
 			{
 				// If we are re-using physics frames for update, we don't even want to care
 				// about gCoreApplication().getFixedUpdateStep(), just grab the most recent interpolated timestamp
 				// like we are in Update.
-				timestamp = calculateInterpolationTime() + (mExtrapolationAmount * 1000);
+				if (mUsePrediction)
+					timestamp = calculatePredictionTime(mLeap->getFrameTime());
+				else
+					timestamp = calculateInterpolationTime(mLeap->getFrameTime()) + (mExtrapolationAmount * 1000);
 			} break;
 			default:
-				LOGERR("Unexpected frame optimization mode: " + mFrameOptimization);
+				LOGERR("Unexpected frame optimization mode: " + mActiveFrameOptimization);
+			}
+			// Sub-steps of one render frame mostly land between the same two tracking frames, the interpolator keeps them.
+			// Other providers sampling the same sub-steps get a copy of the frame instead.
+			{
+				StageTiming timing(mStageTimings, LeapProviderStage::FixedFetch);
+
+				if (mUsePrediction)
+					success = mLeap->getPredictedFrame(timestamp, &mUntransformedFixedFrame, mPredictor);
+				else
+				{
+					success = mLeap->getSharedFrameAt(timestamp, gTime().getFrameIdx(), &mUntransformedFixedFrame,
+						mFixedInterpolator);
+				}
 			}
-			bool success = mLeap->getInterpolatedFrame(timestamp, &mUntransformedFixedFrame);
-			if (!success)
-				return;
 		}
 		else
 		{
-			*mUntransformedFixedFrame.get() = mLeap->getFrame();
+			StageTiming timing(mStageTimings, LeapProviderStage::FixedFetch);
+			success = mLeap->getFrame(&mUntransformedFixedFrame);
 		}
 
+		recordFrameCost(true, gTime().getTimePrecise() - fetchStart);
+		if (!success)
+			return;
+
 		if (mUntransformedFixedFrame.get() != NULL)
 		{
-			_transformFrame(mUntransformedFixedFrame, mTransformedFixedFrame);
+			mFixedFrameView.reset(mUntransformedFixedFrame.get(), SO()->getTransform(), SO()->getTransformHash());
 
-			handleFixedFrameEvent(mTransformedFixedFrame.get());
+			handleFixedFrameEvent();
 		}
 	}
 
-	void CLeapServiceProvider::onInitialized()
-	{
-		mSmoothedTrackingLatency.setBlend(0.99f, 0.0111f);
-	}
-
 	void CLeapServiceProvider::onDestroyed()
 	{
 		releaseService();
@@ -3,8 +3,10 @@
 #pragma once
 
 #include "Leap/BsLeapService.h"
+#include "Leap/BsLeapFramePool.h"
+#include "Leap/BsLeapFrameView.h"
+#include "Leap/BsLeapTimingHistogram.h"
 #include "Scene/BsComponent.h"
-#include "Utility/BsSmoothedFloat.h"
 
 namespace bs
 {
@@ -12,6 +14,46 @@ namespace bs
 	 *  @{
 	  */
 
+	/** Stages of the work done by CLeapServiceProvider every update and fixed update, timed separately. */
+	enum class LeapProviderStage
+	{
+		/** Sampling of the clocks and smoothing of the tracking latency, paid by the first provider of every frame. */
+		LatencySmoothing,
+		/** Retrieval of the update frame, from the history, the predictor or the service. */
+		UpdateFetch,
+		/** Retrieval of the fixed update frame. */
+		FixedFetch,
+		/** Transformation of a whole frame to world space. Also counted in the dispatch it is triggered from. */
+		Transform,
+		/** Triggering of the update frame events, including every subscriber. */
+		UpdateDispatch,
+		/** Triggering of the fixed update frame events, including every subscriber. */
+		FixedDispatch,
+		Count
+	};
+
+	/** Time spent by a single subscriber of the CLeapServiceProvider frame events. */
+	struct LeapSubscriberTimingStats
+	{
+		/** Name given to the subscriber when it connected. */
+		String mName;
+
+		/** Identifier given to the subscriber when it connected, telling apart subscribers sharing a name. */
+		UINT64 mSubscriberId = 0;
+
+		LeapTimingStats mStats;
+	};
+
+	/** Time spent by CLeapServiceProvider in every stage of its work, and in every timed subscriber. */
+	struct LeapProviderTimingStats
+	{
+		/** Statistics of every stage, indexed by LeapProviderStage. */
+		LeapTimingStats mStages[(UINT32)LeapProviderStage::Count];
+
+		/** Statistics of every subscriber connected through one of the timed connect methods. */
+		Vector<LeapSubscriberTimingStats> mSubscribers;
+	};
+
 	/**
 	 * The HandModelManager manages a pool of LeapHandModelBases and makes
 	 * HandRepresentations when it detects a Leap Hand from LeapService.
@@ -27,6 +69,11 @@ namespace bs
 			FrameOptimizationNone,
 			FrameOptimizationReuseUpdateForPhysics,
 			FrameOptimizationReusePhysicsForUpdate,
+			/**
+			 * Picks one of the other modes at runtime, from the measured cost of computing frames and from the update
+			 * and fixed update rates.
+			 */
+			FrameOptimizationAuto,
 		};
 
 		enum PhysicsExtrapolationMode {
@@ -41,22 +88,32 @@ namespace bs
 		/**
 		 * The current frame for this update cycle, in world space.
 		 *
-		 * IMPORTANT!  This frame might be mutable!  If you hold onto a reference
-		 * to this frame, or a reference to any object that is a part of this frame,
-		 * it might change unexpectedly.  If you want to save a reference, make sure
-		 * to make a copy.
+		 * The frame is an immutable snapshot. Every update publishes a new snapshot instead of changing this one, so the
+		 * reference can be kept across frames without copying, and stays valid until it is released.
+		 *
+		 * The whole frame is transformed to world space on the first call of the cycle. Readers only interested in a few
+		 * joints should prefer getCurrentFrameView().
 		 */
-		LeapFrame* getCurrentFrame();
+		LeapFrameRef getCurrentFrame();
 
 		/**
 		 * The current frame for this fixed update cycle, in world space.
 		 *
-		 * IMPORTANT!  This frame might be mutable!  If you hold onto a reference
-		 * to this frame, or a reference to any object that is a part of this frame,
-		 * it might change unexpectedly.  If you want to save a reference, make sure
-		 * to make a copy.
+		 * The frame is an immutable snapshot, see getCurrentFrame().
+		 */
+		LeapFrameRef getCurrentFixedFrame();
+
+		/**
+		 * World space view of the current frame for this update cycle, transforming joints as they are accessed. Valid
+		 * until the next update.
 		 */
-		LeapFrame* getCurrentFixedFrame();
+		const LeapFrameView& getCurrentFrameView() const;
+
+		/**
+		 * World space view of the current frame for this fixed update cycle, transforming joints as they are accessed.
+		 * Valid until the next fixed update.
+		 */
+		const LeapFrameView& getCurrentFixedFrameView() const;
 
 		/**
 		 * Returns true if the Leap Motion hardware is plugged in and this application is
@@ -68,24 +125,76 @@ namespace bs
 		 * Retransforms hand data from Leap space to the space of the Unity transform.
 		 * This is only necessary if you're moving the LeapServiceProvider around in a
 		 * custom script and trying to access Hand data from it directly afterward.
+		 * Frames are left alone if the transform didn't change since they were computed. Whole frames returned by
+		 * getCurrentFrame() and getCurrentFixedFrame() are retransformed when they are next requested.
 		 */
 		void retransformFrames();
 
+		/**
+		 * Returns the predictor used when prediction is enabled. Gives the confidence in the joints of the current frames,
+		 * at the times returned by their timestamps.
+		 */
+		const LeapFramePredictor& getPredictor() const { return mPredictor; }
+
+		/** Returns the frame optimization mode in use, which is picked at runtime when the mode is automatic. */
+		FrameOptimizationMode getActiveFrameOptimization() const { return mActiveFrameOptimization; }
+
 	public:
 		typedef void(*PfnOnDevice)(SPtr<LeapDevice> device);
 
 		/** Event to get a callback whenever a new device is connected to the service. */
 		Event<void(SPtr<LeapDevice> device)> onDeviceSafe;
 
+		/**
+		 * Triggered on every update with the whole current frame in world space. The frame is only transformed if this
+		 * event has subscribers.
+		 */
 		Event<void(const LeapFrame*)> onUpdateFrame;
+
+		/** Triggered on every fixed update with the whole current fixed frame in world space. */
 		Event<void(const LeapFrame*)> onFixedFrame;
 
+		/**
+		 * Triggered on every update with a world space view of the current frame. Cheaper than onUpdateFrame for
+		 * subscribers that only read a few joints, as only the accessed joints are transformed.
+		 */
+		Event<void(const LeapFrameView&)> onUpdateFrameView;
+
+		/** Triggered on every fixed update with a world space view of the current fixed frame. */
+		Event<void(const LeapFrameView&)> onFixedFrameView;
+
 		/**
 		* Event to get a callback whenever a new device is connected to the service.
 		* This callback will ALSO trigger a callback upon subscription if a device is connected.
 		*/
 		HEvent onDeviceSafeConnect(std::function<void(SPtr<LeapDevice>)> func);
 
+		/** @name Timed subscription
+		 *  Subscribes to the matching event, recording the time spent in @p func under @p name. The time shows up in
+		 *  getTimingStats() and as a ProfilerCPU sample. Subscribers connecting under the same name and @p subscriberId,
+		 *  like one that reconnects, share their statistics. Instances of a class connecting under the same name should
+		 *  pass their own id, like GameObject::getInstanceId(), to be timed separately.
+		 *  @{
+		 */
+		HEvent onUpdateFrameConnect(std::function<void(const LeapFrame*)> func, const String& name,
+			UINT64 subscriberId = 0);
+		HEvent onFixedFrameConnect(std::function<void(const LeapFrame*)> func, const String& name,
+			UINT64 subscriberId = 0);
+		HEvent onUpdateFrameViewConnect(std::function<void(const LeapFrameView&)> func, const String& name,
+			UINT64 subscriberId = 0);
+		HEvent onFixedFrameViewConnect(std::function<void(const LeapFrameView&)> func, const String& name,
+			UINT64 subscriberId = 0);
+		/** @} */
+
+		/**
+		 * Returns the time spent in every stage of the updates and in every timed subscriber, since the start or the last
+		 * call to resetTimingStats(). Must be called from the main thread.
+		 */
+		LeapProviderTimingStats getTimingStats() const;
+
+		/** Forgets every recorded timing. */
+		void resetTimingStats();
+
 	protected:
 		/**
 		* Initializes leap Motion policy flags and subscribes to its connection event.
@@ -103,36 +212,133 @@ namespace bs
 		void releaseService();
 
 		/**
-		 * Checks whether the provider is connected to a service. If it is not, attempt to
-		 * reconnect at regular intervals for MAX_RECONNECTION_ATTEMPTS.
+		 * Returns the time on the Leap clock at which to sample the frame shown at engine time @p time (in microseconds,
+		 * as reported by Time::getTimePrecise()), accounting for the tracking latency.
 		 */
-		bool checkConnectionIntegrity();
+		INT64 calculateInterpolationTime(UINT64 time);
 
-		int64_t calculateInterpolationTime();
+		/**
+		 * Returns the time on the Leap clock at which to predict the frame shown at engine time @p time (in
+		 * microseconds, as reported by Time::getTimePrecise()), extrapolated by the extrapolation amount.
+		 */
+		INT64 calculatePredictionTime(UINT64 time);
+
+		/** Returns the engine time of the current fixed update, in microseconds. Must be called once per fixed update. */
+		UINT64 calculateFixedUpdateTime();
 
 		float calculatePhysicsExtrapolation();
 
-		void handleUpdateFrameEvent(LeapFrame* frame);
+		/**
+		 * Picks the frame optimization mode in use. In automatic mode, the mode computing frames for the least time per
+		 * second is picked once per evaluation interval, among those whose timing error stays under
+		 * mMaxFrameReuseError. To avoid flip-flopping, a new mode must be cheaper than the current one by a margin for
+		 * several evaluations in a row, unless the current one became too inaccurate.
+		 */
+		void updateFrameOptimization();
 
-		void handleFixedFrameEvent(LeapFrame* frame);
+		/**
+		 * Returns the time spent computing frames per second with @p mode, in microseconds, given the number of updates
+		 * and fixed updates per second.
+		 */
+		float estimateFrameOptimizationCost(FrameOptimizationMode mode, float updateRate, float fixedRate) const;
+
+		/**
+		 * Returns the age of the frames reused with @p mode by the time they are used, in seconds, given the number of
+		 * updates per second.
+		 */
+		float estimateFrameOptimizationError(FrameOptimizationMode mode, float updateRate) const;
+
+		/**
+		 * Records the time spent fetching a new update or fixed update frame, in microseconds, for automatic mode. Called
+		 * once per fetched frame, as it also counts the frame.
+		 */
+		void recordFrameCost(bool isFixed, UINT64 cost);
+
+		/**
+		 * Adds time spent on the current update or fixed update frame after it was fetched, in microseconds, like
+		 * transforming it, without counting another frame.
+		 */
+		void addFrameCost(bool isFixed, UINT64 cost);
+
+		void handleUpdateFrameEvent();
+
+		void handleFixedFrameEvent();
+
+		/** Identifies what a transformed frame was computed from, so unchanged frames aren't transformed again. */
+		struct TransformedFrameSource
+		{
+			bool mIsValid = false;
+			INT64 mFrameId = 0;
+			INT64 mTimestamp = 0;
+			UINT32 mTransformHash = 0;
+		};
 
-		void _transformFrame(const LeapFrameAlloc& source, LeapFrameAlloc& dest);
+		/**
+		 * Publishes a new snapshot in @p dest holding @p source transformed to world space. Does nothing if neither
+		 * @p source nor the transform of the scene object changed since @p last was recorded.
+		 *
+		 * @param source	Frame in Leap space.
+		 * @param dest		Receives the frame in world space.
+		 * @param last		Describes the previous transformation into @p dest. Updated on return.
+		 * @returns			True if a new frame was published.
+		 */
+		bool _transformFrame(const LeapFrameAlloc& source, LeapFrameRef& dest, TransformedFrameSource& last);
 
 	private:
+		/** Histogram of the time spent in a subscriber, shared with the wrapper calling it. */
+		struct SubscriberTiming
+		{
+			String mName;
+			UINT64 mSubscriberId = 0;
+			LeapTimingHistogram mHistogram;
+		};
+
+		/**
+		 * Connects @p func to @p event, wrapped so that the time spent in it is recorded under @p name and
+		 * @p subscriberId.
+		 */
+		template<class T>
+		HEvent connectTimed(Event<void(T)>& event, std::function<void(T)> func, const String& name, UINT64 subscriberId);
+
 		void onDeviceInit(const LEAP_DEVICE_EVENT *deviceEvent);
 
 		void triggerOnDeviceSafe(const LEAP_DEVICE_EVENT *deviceEvent);
 
 	protected:
-		/** The maximum number of times the provider will attempt to reconnect to the service. */
-		const int MAX_RECONNECTION_ATTEMPTS = 5;
-
-		/** The number of frames to wait between each reconnection attempt. */
-		const int RECONNECTION_INTERVAL = 180;
-
 		/** When enabled, the provider will only calculate one leap frame instead of two. */
 		FrameOptimizationMode mFrameOptimization = FrameOptimizationNone;
 
+		/** Largest age, in seconds, automatic mode accepts for frames reused between update and fixed update. */
+		float mMaxFrameReuseError = 1.0f / 60.0f;
+
+		/** Mode in use. Same as mFrameOptimization, except in automatic mode. */
+		FrameOptimizationMode mActiveFrameOptimization = FrameOptimizationNone;
+
+		/** Measurements of automatic mode over the current evaluation interval. Costs are in microseconds. */
+		struct FrameOptimizationWindow
+		{
+			UINT64 mStart = 0;
+			UINT32 mNumUpdates = 0;
+			UINT32 mNumFixedUpdates = 0;
+			UINT64 mUpdateCost = 0;
+			UINT32 mNumUpdateFrames = 0;
+			UINT64 mFixedCost = 0;
+			UINT32 mNumFixedFrames = 0;
+		};
+
+		FrameOptimizationWindow mOptimizationWindow;
+
+		/**
+		 * Average time to compute an update and a fixed update frame, in microseconds, or 0 if never measured. Kept across
+		 * evaluation intervals, as modes reusing frames only measure one of them.
+		 */
+		float mUpdateFrameCost = 0.0f;
+		float mFixedFrameCost = 0.0f;
+
+		/** Mode automatic mode is about to switch to, and for how many evaluations in a row it was preferred. */
+		FrameOptimizationMode mPendingFrameOptimization = FrameOptimizationNone;
+		UINT32 mNumPendingEvaluations = 0;
+
 		/**
 		 * The mode to use when extrapolating physics.
 		 * None - No extrapolation is used at all.
@@ -143,6 +349,13 @@ namespace bs
 
 		bool mUseInterpolation = true;
 
+		/**
+		 * When enabled along interpolation, frames are predicted at the current time plus the extrapolation amount
+		 * from the motion of the hands, instead of being interpolated at a time delayed by the tracking latency. The
+		 * bounce amount is ignored.
+		 */
+		bool mUsePrediction = false;
+
 		int mBounceAmount = 0;
 
 		int mExtrapolationAmount = 0;
@@ -152,20 +365,32 @@ namespace bs
 
 		LeapService* mLeap = NULL;
 
-		SmoothedFloat mSmoothedTrackingLatency;
-		uint64_t mBsToLeapOffset;
+		UINT64 mFixedUpdateTime = 0;
 
 		LeapFrameAlloc mUntransformedUpdateFrame;
-		LeapFrameAlloc mTransformedUpdateFrame;
 		LeapFrameAlloc mUntransformedFixedFrame;
-		LeapFrameAlloc mTransformedFixedFrame;
+		LeapFrameInterpolator mUpdateInterpolator;
+		LeapFrameInterpolator mFixedInterpolator;
+		LeapFramePredictor mPredictor;
 
-	private:
-		int mFramesSinceServiceConnectionChecked = 0;
-		int mNumberOfReconnectionAttempts = 0;
+		/** Snapshots the transformed frames are published in. Declared first so it outlives them. */
+		LeapFramePool mFramePool;
+		LeapFrameRef mTransformedUpdateFrame;
+		LeapFrameRef mTransformedFixedFrame;
+		TransformedFrameSource mUpdateFrameSource;
+		TransformedFrameSource mFixedFrameSource;
+
+		LeapFrameView mUpdateFrameView;
+		LeapFrameView mFixedFrameView;
 
+	private:
+		HEvent mOnDeviceSafeConn;
 		HEvent mOnDeviceInitConn;
 
+		/** Time spent in every stage, indexed by LeapProviderStage. */
+		LeapTimingHistogram mStageTimings[(UINT32)LeapProviderStage::Count];
+		Vector<SPtr<SubscriberTiming>> mSubscriberTimings;
+
 		/*********************************************************************** */
 		/* 						COMPONENT OVERRIDES                      		 */
 		/*********************************************************************** */
@@ -179,9 +404,6 @@ namespace bs
 	protected:
 		friend class SceneObject;
 
-		/** @copydoc Component::onInitialized  */
-		void onInitialized() override;
-
 		/** @copydoc Component::onDestroyed */
 		void onDestroyed() override;
 
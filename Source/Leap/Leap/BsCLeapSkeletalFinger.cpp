@@ -31,7 +31,7 @@ namespace bs
 		{
 			if (mBones[i] != NULL)
 			{
-				mBones[i]->setWorldPosition(getBoneCenter(i));
+				setJointWorldPosition(mBones[i], getBoneCenter(i));
 				//mBones[i]->setRotation(getBoneRotation(i));
 			}
 		}
@@ -40,7 +40,7 @@ namespace bs
 		{
 			if (mJoints[i] != NULL)
 			{
-				mJoints[i]->setWorldPosition(getJointPosition(i + 1));
+				setJointWorldPosition(mJoints[i], getJointPosition(i + 1));
 				//mJoints[i]->setRotation(getBoneRotation(i + 1));
 			}
 		}
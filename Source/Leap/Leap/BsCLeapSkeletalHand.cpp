@@ -45,19 +45,19 @@ namespace bs
 
 		if (mPalm != NULL)
 		{
-			mPalm->setWorldPosition(getPalmCenter());
+			setJointWorldPosition(mPalm, getPalmCenter());
 			//mPalm->setRotation(getPalmRotation());
 		}
 
 		if (mWristJoint != NULL)
 		{
-			mWristJoint->setWorldPosition(getWristPosition());
+			setJointWorldPosition(mWristJoint, getWristPosition());
 			//mWristJoint->setRotation(getPalmRotation());
 		}
 
 		if (mForearm != NULL)
 		{
-			mForearm->setWorldPosition(getArmCenter());
+			setJointWorldPosition(mForearm, getArmCenter());
 			//mForearm->setRotation(getArmRotation());
 		}
 	}
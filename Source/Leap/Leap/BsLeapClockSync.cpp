@@ -0,0 +1,136 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapClockSync.h"
+#include "Leap/BsLeapLogRing.h"
+
+namespace bs
+{
+	LeapClockSync::LeapClockSync(UINT32 windowSize)
+		: mSamples(std::max(windowSize, 2U))
+	{
+		eLeapRS result = LeapCreateClockRebaser(&mRebaser);
+		if (result != eLeapRS_Success)
+		{
+			LOGWRN("LeapCreateClockRebaser call was " + toString(result) + ", falling back to a fitted clock mapping.");
+			mRebaser = nullptr;
+		}
+
+		mStats.mUsesRebaser = mRebaser != nullptr;
+	}
+
+	LeapClockSync::~LeapClockSync()
+	{
+		if (mRebaser != nullptr)
+			LeapDestroyClockRebaser(mRebaser);
+	}
+
+	void LeapClockSync::update(INT64 engineTime, INT64 leapTime)
+	{
+		if (isValid())
+			mStats.mLastPredictionError = leapTime - toLeapTime(engineTime);
+
+		if (mRebaser != nullptr)
+		{
+			eLeapRS result = LeapUpdateRebase(mRebaser, engineTime, leapTime);
+			if (result != eLeapRS_Success)
+				LOGWRN("LeapUpdateRebase call was " + toString(result));
+		}
+
+		mSamples[mNextSample] = { engineTime, leapTime };
+		mNextSample = (mNextSample + 1) % (UINT32)mSamples.size();
+		mNumSamples = std::min(mNumSamples + 1, (UINT32)mSamples.size());
+
+		fit();
+	}
+
+	void LeapClockSync::reset()
+	{
+		// The rebaser has no reset, so a fresh one is needed to forget its history
+		if (mRebaser != nullptr)
+		{
+			LeapDestroyClockRebaser(mRebaser);
+			if (LeapCreateClockRebaser(&mRebaser) != eLeapRS_Success)
+				mRebaser = nullptr;
+		}
+
+		mNextSample = 0;
+		mNumSamples = 0;
+		mSlope = 1.0;
+		mIntercept = 0.0;
+
+		mStats = LeapClockSyncStats();
+		mStats.mUsesRebaser = mRebaser != nullptr;
+	}
+
+	INT64 LeapClockSync::toLeapTime(INT64 engineTime) const
+	{
+		if (mRebaser != nullptr)
+		{
+			INT64 leapTime;
+			if (LeapRebaseClock(mRebaser, engineTime, &leapTime) == eLeapRS_Success)
+				return leapTime;
+		}
+
+		return evaluateFit(engineTime);
+	}
+
+	INT64 LeapClockSync::toEngineTime(INT64 leapTime) const
+	{
+		return mOrigin + (INT64)(((double)(leapTime - mOrigin) - mIntercept) / mSlope);
+	}
+
+	void LeapClockSync::fit()
+	{
+		// Times relative to the newest sample keep the sums small enough for doubles to stay exact
+		const Sample& newest = mSamples[(mNextSample + (UINT32)mSamples.size() - 1) % (UINT32)mSamples.size()];
+		mOrigin = newest.mEngineTime;
+
+		double meanX = 0.0;
+		double meanY = 0.0;
+		for (UINT32 i = 0; i < mNumSamples; ++i)
+		{
+			meanX += (double)(mSamples[i].mEngineTime - mOrigin);
+			meanY += (double)(mSamples[i].mLeapTime - mOrigin);
+		}
+
+		meanX /= mNumSamples;
+		meanY /= mNumSamples;
+
+		double sxx = 0.0;
+		double sxy = 0.0;
+		for (UINT32 i = 0; i < mNumSamples; ++i)
+		{
+			double dx = (double)(mSamples[i].mEngineTime - mOrigin) - meanX;
+			double dy = (double)(mSamples[i].mLeapTime - mOrigin) - meanY;
+
+			sxx += dx * dx;
+			sxy += dx * dy;
+		}
+
+		// A paused engine clock gives no information about the rate, keep assuming both clocks run at the same one
+		mSlope = sxx > 0.0 ? sxy / sxx : 1.0;
+		mIntercept = meanY - mSlope * meanX;
+
+		double sumSquares = 0.0;
+		double maxResidual = 0.0;
+		for (UINT32 i = 0; i < mNumSamples; ++i)
+		{
+			double residual = std::abs((double)(mSamples[i].mLeapTime - evaluateFit(mSamples[i].mEngineTime)));
+
+			sumSquares += residual * residual;
+			maxResidual = std::max(maxResidual, residual);
+		}
+
+		mStats.mRmsResidual = std::sqrt(sumSquares / mNumSamples);
+		mStats.mMaxResidual = maxResidual;
+		mStats.mDriftPpm = (mSlope - 1.0) * 1e6;
+		mStats.mOffset = evaluateFit(mOrigin) - mOrigin;
+		mStats.mNumSamples = mNumSamples;
+	}
+
+	INT64 LeapClockSync::evaluateFit(INT64 engineTime) const
+	{
+		return mOrigin + (INT64)(mIntercept + mSlope * (double)(engineTime - mOrigin));
+	}
+}
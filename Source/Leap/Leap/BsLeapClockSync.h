@@ -0,0 +1,107 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	/** Quality of the mapping kept by LeapClockSync. All times are in microseconds. */
+	struct LeapClockSyncStats
+	{
+		/**
+		 * Difference between the Leap time sampled by the last update() and the time toLeapTime() predicted for it just
+		 * before. Measures how well the mapping predicts the Leap clock.
+		 */
+		INT64 mLastPredictionError = 0;
+
+		/** Root mean square distance of the samples in the window to the fitted line. Measures sampling jitter. */
+		double mRmsResidual = 0.0;
+
+		/** Largest distance of a sample in the window to the fitted line. */
+		double mMaxResidual = 0.0;
+
+		/** Rate of the Leap clock relative to the engine clock minus one, in parts per million. */
+		double mDriftPpm = 0.0;
+
+		/** Leap time minus engine time, at the newest sample. */
+		INT64 mOffset = 0;
+
+		/** Number of samples in the window. */
+		UINT32 mNumSamples = 0;
+
+		/** True if the LeapC clock rebaser is used for toLeapTime(). */
+		bool mUsesRebaser = false;
+	};
+
+	/**
+	 * Maps between the engine clock and the Leap Motion clock, both in microseconds. update() samples both clocks once
+	 * per rendered frame. The pairs feed the LeapC clock rebaser, which is used for engine to Leap conversions as LeapC
+	 * recommends. They are also kept in a sliding window fitted with a line by least squares, which gives the offset
+	 * and drift between the clocks, the inverse mapping, and a fallback if the rebaser is unavailable.
+	 *
+	 * Must only be used from a single thread.
+	 */
+	class LeapClockSync
+	{
+	public:
+		/** Constructs a clock sync fitting the last @p windowSize samples. */
+		LeapClockSync(UINT32 windowSize = 120);
+		LeapClockSync(const LeapClockSync&) = delete;
+		~LeapClockSync();
+
+		/**
+		 * Records the two clocks sampled at about the same time. Must be called once per rendered frame, as the engine
+		 * clock can be paused or slowed down.
+		 */
+		void update(INT64 engineTime, INT64 leapTime);
+
+		/** Forgets every sample, used when the relationship between the clocks is lost. */
+		void reset();
+
+		/** Returns true once at least one sample was recorded, before which no conversion is possible. */
+		bool isValid() const { return mNumSamples > 0; }
+
+		/** Converts a time on the engine clock to the Leap clock. */
+		INT64 toLeapTime(INT64 engineTime) const;
+
+		/** Converts a time on the Leap clock to the engine clock. */
+		INT64 toEngineTime(INT64 leapTime) const;
+
+		/** Returns the quality of the mapping. */
+		const LeapClockSyncStats& getStats() const { return mStats; }
+
+	private:
+		/** Pair of clock samples. */
+		struct Sample
+		{
+			INT64 mEngineTime;
+			INT64 mLeapTime;
+		};
+
+		/** Fits mSlope and mIntercept to the samples in the window and updates the residual statistics. */
+		void fit();
+
+		/** Evaluates the fitted line at @p engineTime. */
+		INT64 evaluateFit(INT64 engineTime) const;
+
+		LEAP_CLOCK_REBASER mRebaser = nullptr;
+
+		Vector<Sample> mSamples;
+		UINT32 mNextSample = 0;
+		UINT32 mNumSamples = 0;
+
+		/** The fit maps engine time relative to mOrigin to Leap time relative to mOrigin plus mIntercept. */
+		INT64 mOrigin = 0;
+		double mSlope = 1.0;
+		double mIntercept = 0.0;
+
+		LeapClockSyncStats mStats;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,90 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapConnectionMonitor.h"
+
+namespace bs
+{
+	constexpr std::chrono::milliseconds LeapConnectionMonitor::CHECK_INTERVAL;
+	constexpr std::chrono::milliseconds LeapConnectionMonitor::INITIAL_RETRY_DELAY;
+	constexpr std::chrono::milliseconds LeapConnectionMonitor::MAX_RETRY_DELAY;
+
+	LeapConnectionMonitor::LeapConnectionMonitor(std::function<bool()> checkConnection,
+		std::function<void(UINT32)> reconnect)
+		: mCheckConnection(std::move(checkConnection)), mReconnect(std::move(reconnect))
+	{ }
+
+	LeapConnectionMonitor::~LeapConnectionMonitor()
+	{
+		stop();
+	}
+
+	void LeapConnectionMonitor::start()
+	{
+		Lock lock(mMutex);
+		if (mIsRunning)
+			return;
+
+		mIsRunning = true;
+		mThread = bs_new<Thread>(std::bind(&LeapConnectionMonitor::run, this));
+	}
+
+	void LeapConnectionMonitor::stop()
+	{
+		{
+			Lock lock(mMutex);
+			if (!mIsRunning)
+				return;
+
+			mIsRunning = false;
+		}
+
+		mSignal.notify_all();
+
+		mThread->join();
+		bs_delete(mThread);
+		mThread = nullptr;
+	}
+
+	void LeapConnectionMonitor::run()
+	{
+		std::chrono::milliseconds retryDelay = INITIAL_RETRY_DELAY;
+		bool wasHealthy = true;
+		UINT32 numAttempts = 0;
+
+		Lock lock(mMutex);
+		while (true)
+		{
+			std::chrono::milliseconds wait = wasHealthy ? CHECK_INTERVAL : retryDelay;
+			mSignal.wait_for(lock, wait, [this]() { return !mIsRunning; });
+
+			if (!mIsRunning)
+				break;
+
+			// Checks and reconnections can take a while, stop() only needs the lock to signal the thread
+			lock.unlock();
+
+			if (mCheckConnection())
+			{
+				wasHealthy = true;
+				retryDelay = INITIAL_RETRY_DELAY;
+				numAttempts = 0;
+			}
+			else if (wasHealthy)
+			{
+				// Gives the connection a chance to recover on its own before it is torn down
+				wasHealthy = false;
+			}
+			else
+			{
+				numAttempts++;
+				mNumReconnections.fetch_add(1, std::memory_order_relaxed);
+				mReconnect(numAttempts);
+
+				retryDelay = std::min(retryDelay * 2, MAX_RETRY_DELAY);
+			}
+
+			lock.lock();
+		}
+	}
+}
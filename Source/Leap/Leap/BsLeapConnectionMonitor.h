@@ -0,0 +1,74 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	/**
+	 * Watches the health of the connection to the Leap Motion service from a background thread, so that the thread
+	 * polling for frames never pays for it.
+	 *
+	 * The connection is checked at a regular interval. Once it is found unhealthy it gets a grace period to recover on
+	 * its own, as LeapC reconnects by itself after short service interruptions. If it still isn't healthy afterwards it
+	 * is reconnected, and the delay before the next attempt doubles with every failed attempt, up to a maximum. A healthy
+	 * check resets the delay.
+	 */
+	class LeapConnectionMonitor
+	{
+	public:
+		/**
+		 * Constructs a monitor. Both callbacks are called from the monitor thread.
+		 *
+		 * @param checkConnection	Returns true if the connection is healthy.
+		 * @param reconnect			Tears down and reopens the connection. Receives the number of the attempt, starting
+		 *							at one for the first attempt since the connection was last healthy.
+		 */
+		LeapConnectionMonitor(std::function<bool()> checkConnection, std::function<void(UINT32)> reconnect);
+		LeapConnectionMonitor(const LeapConnectionMonitor&) = delete;
+		~LeapConnectionMonitor();
+
+		/** Starts the monitor thread. */
+		void start();
+
+		/** Stops the monitor thread, waiting for a reconnection in progress to complete. */
+		void stop();
+
+		/** Returns the total number of reconnections attempted. */
+		UINT32 getNumReconnections() const { return mNumReconnections.load(std::memory_order_relaxed); }
+
+	public:
+		/** Interval at which a healthy connection is checked. */
+		static constexpr std::chrono::milliseconds CHECK_INTERVAL{ 500 };
+
+		/** Delay before the first reconnection attempt, after the connection was found unhealthy. */
+		static constexpr std::chrono::milliseconds INITIAL_RETRY_DELAY{ 1000 };
+
+		/** Maximum delay between two reconnection attempts. */
+		static constexpr std::chrono::milliseconds MAX_RETRY_DELAY{ 30000 };
+
+	private:
+		/** Entry point of the monitor thread. */
+		void run();
+
+		std::function<bool()> mCheckConnection;
+		std::function<void(UINT32)> mReconnect;
+
+		Thread* mThread = nullptr;
+		bool mIsRunning = false;
+		Mutex mMutex;
+		Signal mSignal;
+
+		std::atomic<UINT32> mNumReconnections{ 0 };
+	};
+
+	/** @} */
+}
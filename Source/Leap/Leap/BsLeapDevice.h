@@ -4,6 +4,8 @@
 
 #include "Leap/BsLeapPrerequisites.h"
 
+#include <atomic>
+
 namespace bs
 {
 	/** @addtogroup Leap
@@ -15,6 +17,9 @@ namespace bs
 	 * 
 	 * The LeapDevice class contains information related to a particular connected device such as device id, field of view
 	 * relative to the device, and the position and orientation of the device in relative coordinates.
+	 *
+	 * LeapService fills in the properties before publishing the device and never changes them afterwards. Only the status
+	 * keeps being updated by the message pump thread, and can be read from any thread.
 	 */
 	class LeapDevice
 	{
@@ -29,13 +34,26 @@ namespace bs
 			mRange = range;
 			mBaseline = baseline;
 			mType = type;
-			mIsStreaming = isStreaming;
+			mIsStreaming.store(isStreaming, std::memory_order_relaxed);
 			mSerialNumber = serialNumber;
 		}
 
 		/** For internal use only. */
 		LeapDeviceHandle getHandle() const { return mHandle; }
 
+		/** For internal use only. Updates the device state from a combination of eLeapDeviceStatus flags. */
+		void setStatus(UINT32 status)
+		{
+			mStatus.store(status, std::memory_order_relaxed);
+			mIsStreaming.store((status & eLeapDeviceStatus_Streaming) != 0, std::memory_order_relaxed);
+		}
+
+		/**
+		 * The most recent combination of eLeapDeviceStatus flags reported for this device, such as
+		 * eLeapDeviceStatus_Smudged or eLeapDeviceStatus_LowResource.
+		 */
+		UINT32 getStatus() const { return mStatus.load(std::memory_order_relaxed); }
+
 		/**
 		 * The angle in radians of view along the x axis of this device.
 		 * 
@@ -77,7 +95,7 @@ namespace bs
 		 * 
 		 * Currently only one controller can provide data at a time.
 		 */
-		bool isStreaming() const { return mIsStreaming; }
+		bool isStreaming() const { return mIsStreaming.load(std::memory_order_relaxed); }
 
 		/**
 		 * The device type.
@@ -135,7 +153,10 @@ namespace bs
 		float mBaseline;
 
 		/** Reports whether this device is streaming data to your application. */
-		bool mIsStreaming;
+		std::atomic<bool> mIsStreaming{ false };
+
+		/** Combination of eLeapDeviceStatus flags last reported for this device. */
+		std::atomic<UINT32> mStatus{ 0 };
 
 		/** The device type. */
 		eLeapDevicePID mType;
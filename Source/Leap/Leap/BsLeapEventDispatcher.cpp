@@ -0,0 +1,215 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapEventDispatcher.h"
+#include "Threading/BsTaskScheduler.h"
+
+namespace bs
+{
+	LeapEventDispatcher::LeapEventDispatcher(const LeapFrameHistory& frames, UINT32 queueCapacity)
+		: mFrames(frames), mMainThread(queueCapacity), mWorker(queueCapacity)
+	{ }
+
+	LeapEventDispatcher::~LeapEventDispatcher()
+	{
+		waitForWorker();
+	}
+
+	HEvent LeapEventDispatcher::connectConnection(std::function<void(const LEAP_CONNECTION_EVENT*)> func,
+		LeapDeliveryPolicy policy)
+	{
+		return subscribe(policy, LeapQueuedEventType::Connection).onConnection.connect(func);
+	}
+
+	HEvent LeapEventDispatcher::connectConnectionLost(std::function<void(const LEAP_CONNECTION_LOST_EVENT*)> func,
+		LeapDeliveryPolicy policy)
+	{
+		return subscribe(policy, LeapQueuedEventType::ConnectionLost).onConnectionLost.connect(func);
+	}
+
+	HEvent LeapEventDispatcher::connectDevice(std::function<void(const LEAP_DEVICE_EVENT*)> func,
+		LeapDeliveryPolicy policy)
+	{
+		return subscribe(policy, LeapQueuedEventType::Device).onDevice.connect(func);
+	}
+
+	HEvent LeapEventDispatcher::connectDeviceLost(std::function<void(const LEAP_DEVICE_EVENT*)> func,
+		LeapDeliveryPolicy policy)
+	{
+		return subscribe(policy, LeapQueuedEventType::DeviceLost).onDeviceLost.connect(func);
+	}
+
+	HEvent LeapEventDispatcher::connectDeviceFailure(std::function<void(const LEAP_DEVICE_FAILURE_EVENT*)> func,
+		LeapDeliveryPolicy policy)
+	{
+		return subscribe(policy, LeapQueuedEventType::DeviceFailure).onDeviceFailure.connect(func);
+	}
+
+	HEvent LeapEventDispatcher::connectDeviceStatusChange(
+		std::function<void(const LEAP_DEVICE_STATUS_CHANGE_EVENT*)> func, LeapDeliveryPolicy policy)
+	{
+		return subscribe(policy, LeapQueuedEventType::DeviceStatusChange).onDeviceStatusChange.connect(func);
+	}
+
+	HEvent LeapEventDispatcher::connectDroppedFrame(std::function<void(const LEAP_DROPPED_FRAME_EVENT*)> func,
+		LeapDeliveryPolicy policy)
+	{
+		return subscribe(policy, LeapQueuedEventType::DroppedFrame).onDroppedFrame.connect(func);
+	}
+
+	HEvent LeapEventDispatcher::connectPolicy(std::function<void(const UINT32)> func, LeapDeliveryPolicy policy)
+	{
+		return subscribe(policy, LeapQueuedEventType::Policy).onPolicy.connect(func);
+	}
+
+	HEvent LeapEventDispatcher::connectFrame(std::function<void(const LeapFrame*)> func, LeapDeliveryPolicy policy)
+	{
+		return subscribe(policy, LeapQueuedEventType::Frame).onFrame.connect(func);
+	}
+
+	void LeapEventDispatcher::post(LeapQueuedEvent event)
+	{
+		UINT32 typeMask = 1U << (UINT32)event.mType;
+		bool toMainThread = (mMainThread.mSubscribedTypes.load(std::memory_order_relaxed) & typeMask) != 0;
+		bool toWorker = (mWorker.mSubscribedTypes.load(std::memory_order_relaxed) & typeMask) != 0;
+
+		if (!toMainThread && !toWorker)
+			return;
+
+		event.mQueuedTime = LeapGetNow();
+
+		if (toMainThread)
+		{
+			if (mMainThread.mQueue.tryPush(event))
+				mMainThread.mNumQueued.fetch_add(1, std::memory_order_relaxed);
+			else
+				mMainThread.mNumOverflowed.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (toWorker)
+		{
+			if (mWorker.mQueue.tryPush(event))
+				mWorker.mNumQueued.fetch_add(1, std::memory_order_relaxed);
+			else
+				mWorker.mNumOverflowed.fetch_add(1, std::memory_order_relaxed);
+
+			// Only one worker task drains the queue at a time, keeping it single consumer
+			if (!mWorkerScheduled.exchange(true, std::memory_order_acq_rel))
+			{
+				mWorkerTask = Task::create("LeapEventDispatch", std::bind(&LeapEventDispatcher::runWorker, this));
+				TaskScheduler::instance().addTask(mWorkerTask);
+			}
+		}
+	}
+
+	void LeapEventDispatcher::dispatchMainThread()
+	{
+		dispatch(mMainThread);
+	}
+
+	void LeapEventDispatcher::waitForWorker()
+	{
+		if (mWorkerTask != nullptr)
+			mWorkerTask->wait();
+	}
+
+	LeapDispatchStats LeapEventDispatcher::getStats(LeapDeliveryPolicy policy) const
+	{
+		LeapDispatchStats stats;
+		if (policy == LeapDeliveryPolicy::Inline)
+			return stats;
+
+		const Channel& channel = policy == LeapDeliveryPolicy::MainThread ? mMainThread : mWorker;
+		stats.mNumQueued = channel.mNumQueued.load(std::memory_order_relaxed);
+		stats.mNumOverflowed = channel.mNumOverflowed.load(std::memory_order_relaxed);
+		stats.mNumDelivered = channel.mNumDelivered.load(std::memory_order_relaxed);
+		stats.mNumExpired = channel.mNumExpired.load(std::memory_order_relaxed);
+		stats.mTotalLatency = channel.mTotalLatency.load(std::memory_order_relaxed);
+		stats.mMaxLatency = channel.mMaxLatency.load(std::memory_order_relaxed);
+
+		return stats;
+	}
+
+	LeapEventDispatcher::Channel& LeapEventDispatcher::subscribe(LeapDeliveryPolicy policy, LeapQueuedEventType type)
+	{
+		assert(policy != LeapDeliveryPolicy::Inline);
+
+		Channel& channel = policy == LeapDeliveryPolicy::Worker ? mWorker : mMainThread;
+		channel.mSubscribedTypes.fetch_or(1U << (UINT32)type, std::memory_order_relaxed);
+
+		return channel;
+	}
+
+	void LeapEventDispatcher::dispatch(Channel& channel)
+	{
+		LeapQueuedEvent event;
+		while (channel.mQueue.tryPop(event))
+			deliver(channel, event);
+	}
+
+	void LeapEventDispatcher::deliver(Channel& channel, const LeapQueuedEvent& event)
+	{
+		// Measured before the subscribers run, so slow subscribers don't inflate the latency of the event they process
+		UINT64 latency = (UINT64)std::max(LeapGetNow() - event.mQueuedTime, (INT64)0);
+
+		switch (event.mType)
+		{
+		case LeapQueuedEventType::Connection:
+			channel.onConnection(&event.mConnection);
+			break;
+		case LeapQueuedEventType::ConnectionLost:
+			channel.onConnectionLost(&event.mConnectionLost);
+			break;
+		case LeapQueuedEventType::Device:
+			channel.onDevice(&event.mDevice);
+			break;
+		case LeapQueuedEventType::DeviceLost:
+			channel.onDeviceLost(&event.mDevice);
+			break;
+		case LeapQueuedEventType::DeviceFailure:
+			channel.onDeviceFailure(&event.mDeviceFailure);
+			break;
+		case LeapQueuedEventType::DeviceStatusChange:
+			channel.onDeviceStatusChange(&event.mDeviceStatusChange);
+			break;
+		case LeapQueuedEventType::DroppedFrame:
+			channel.onDroppedFrame(&event.mDroppedFrame);
+			break;
+		case LeapQueuedEventType::Policy:
+			channel.onPolicy(event.mPolicies);
+			break;
+		case LeapQueuedEventType::Frame:
+			if (!mFrames.readSerial(event.mFrameSerial, channel.mFrame))
+			{
+				channel.mNumExpired.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			channel.onFrame(channel.mFrame.get());
+			break;
+		default:
+			break;
+		}
+
+		channel.mNumDelivered.fetch_add(1, std::memory_order_relaxed);
+		channel.mTotalLatency.fetch_add(latency, std::memory_order_relaxed);
+
+		// Single consumer, so nobody else can raise the maximum in between
+		if (latency > channel.mMaxLatency.load(std::memory_order_relaxed))
+			channel.mMaxLatency.store(latency, std::memory_order_relaxed);
+	}
+
+	void LeapEventDispatcher::runWorker()
+	{
+		while (true)
+		{
+			dispatch(mWorker);
+
+			// An event pushed before the flag is cleared didn't schedule a new task, so check the queue once more and
+			// keep draining if the flag can be re-acquired. Otherwise the producer scheduled a new task already.
+			mWorkerScheduled.store(false, std::memory_order_release);
+			if (mWorker.mQueue.empty() || mWorkerScheduled.exchange(true, std::memory_order_acq_rel))
+				break;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,208 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+#include "Leap/BsLeapFrame.h"
+#include "Leap/BsLeapFrameAlloc.h"
+#include "Leap/BsLeapFrameHistory.h"
+#include "Utility/BsBoundedQueue.h"
+#include "Utility/BsEvent.h"
+
+#include <atomic>
+
+namespace bs
+{
+	class Task;
+
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	/**
+	 * Determines on which thread a subscriber to a LeapService event gets notified.
+	 *
+	 * Only events with a matching LeapService::connect* method honor the policy: connections, devices, dropped frames,
+	 * policies and frames. onImage, onConfigChange, onConfigResponse, onPointMappingChange and onHeadPose are always
+	 * triggered inline on the message pump thread, and onLogMessage always on the main thread.
+	 */
+	enum class LeapDeliveryPolicy
+	{
+		/** Called directly on the LeapC message pump thread. Subscribers must return quickly. */
+		Inline,
+		/** Queued and called on the main thread when LeapService::dispatchQueuedEvents() is called. */
+		MainThread,
+		/** Queued and called from a task running on the TaskScheduler worker pool. */
+		Worker
+	};
+
+	/** Kinds of LeapC events that can be queued by the LeapEventDispatcher. */
+	enum class LeapQueuedEventType
+	{
+		Connection,
+		ConnectionLost,
+		Device,
+		DeviceLost,
+		DeviceFailure,
+		DeviceStatusChange,
+		DroppedFrame,
+		Policy,
+		Frame,
+		Count // Keep at end
+	};
+
+	/** Copy of a LeapC event message, small enough to be stored in a lock-free queue. */
+	struct LeapQueuedEvent
+	{
+		LeapQueuedEventType mType = LeapQueuedEventType::Connection;
+
+		/** Time at which the event was queued, in microseconds on the LeapC clock. */
+		INT64 mQueuedTime = 0;
+
+		union
+		{
+			/** Serial of the frame in the frame history, for LeapQueuedEventType::Frame. */
+			UINT64 mFrameSerial;
+			UINT32 mPolicies;
+			LEAP_CONNECTION_EVENT mConnection;
+			LEAP_CONNECTION_LOST_EVENT mConnectionLost;
+			LEAP_DEVICE_EVENT mDevice;
+			LEAP_DEVICE_FAILURE_EVENT mDeviceFailure;
+			LEAP_DEVICE_STATUS_CHANGE_EVENT mDeviceStatusChange;
+			LEAP_DROPPED_FRAME_EVENT mDroppedFrame;
+		};
+	};
+
+	/** Statistics about the events delivered through one of the queued delivery policies. */
+	struct LeapDispatchStats
+	{
+		/** Number of events added to the queue. */
+		UINT64 mNumQueued = 0;
+		/** Number of events dropped because the queue was full. */
+		UINT64 mNumOverflowed = 0;
+		/** Number of events delivered to subscribers. */
+		UINT64 mNumDelivered = 0;
+		/** Number of frame events dropped because the frame left the frame history before it could be delivered. */
+		UINT64 mNumExpired = 0;
+		/** Sum of the time between queuing and delivery of all delivered events, in microseconds. */
+		UINT64 mTotalLatency = 0;
+		/** Longest time between queuing and delivery of an event, in microseconds. */
+		UINT64 mMaxLatency = 0;
+
+		/** Returns the average time between queuing and delivery of an event, in microseconds. */
+		float getAverageLatency() const { return mNumDelivered > 0 ? (float)mTotalLatency / mNumDelivered : 0.0f; }
+	};
+
+	/**
+	 * Forwards events received on the LeapC message pump thread to subscribers that asked for them to be delivered on
+	 * the main thread or on the worker pool, so that slow subscribers can't delay the next LeapPollConnection() call.
+	 *
+	 * Every queued delivery policy owns a bounded single-producer single-consumer queue. The message pump thread is the
+	 * only producer and never blocks: when a queue is full the event is dropped and counted as an overflow. Frame events
+	 * only carry the serial of the frame in the frame history and the frame is copied out of the history on delivery.
+	 */
+	class LeapEventDispatcher
+	{
+	public:
+		/**
+		 * Constructs a new dispatcher.
+		 *
+		 * @param frames		History the frames of queued frame events are read from.
+		 * @param queueCapacity	Maximum number of events waiting for delivery, per delivery policy.
+		 */
+		LeapEventDispatcher(const LeapFrameHistory& frames, UINT32 queueCapacity);
+		~LeapEventDispatcher();
+
+		/** @name Subscription
+		 *  Subscribes to an event with a queued delivery policy. LeapDeliveryPolicy::Inline is not supported here.
+		 *  @{
+		 */
+		HEvent connectConnection(std::function<void(const LEAP_CONNECTION_EVENT*)> func, LeapDeliveryPolicy policy);
+		HEvent connectConnectionLost(std::function<void(const LEAP_CONNECTION_LOST_EVENT*)> func,
+			LeapDeliveryPolicy policy);
+		HEvent connectDevice(std::function<void(const LEAP_DEVICE_EVENT*)> func, LeapDeliveryPolicy policy);
+		HEvent connectDeviceLost(std::function<void(const LEAP_DEVICE_EVENT*)> func, LeapDeliveryPolicy policy);
+		HEvent connectDeviceFailure(std::function<void(const LEAP_DEVICE_FAILURE_EVENT*)> func,
+			LeapDeliveryPolicy policy);
+		HEvent connectDeviceStatusChange(std::function<void(const LEAP_DEVICE_STATUS_CHANGE_EVENT*)> func,
+			LeapDeliveryPolicy policy);
+		HEvent connectDroppedFrame(std::function<void(const LEAP_DROPPED_FRAME_EVENT*)> func, LeapDeliveryPolicy policy);
+		HEvent connectPolicy(std::function<void(const UINT32)> func, LeapDeliveryPolicy policy);
+		HEvent connectFrame(std::function<void(const LeapFrame*)> func, LeapDeliveryPolicy policy);
+		/** @} */
+
+		/**
+		 * Queues an event for every delivery policy that has subscribers for its type. Must only be called from the
+		 * LeapC message pump thread. The queue time of the event is set by this method.
+		 */
+		void post(LeapQueuedEvent event);
+
+		/** Delivers all events queued for the main thread. Must only be called from the main thread. */
+		void dispatchMainThread();
+
+		/** Blocks until the worker task, if any is running, has finished delivering queued events. */
+		void waitForWorker();
+
+		/** Returns the delivery statistics of a queued delivery policy. */
+		LeapDispatchStats getStats(LeapDeliveryPolicy policy) const;
+
+	private:
+		/** Queue and subscribers of a single queued delivery policy. */
+		struct Channel
+		{
+			Channel(UINT32 queueCapacity)
+				:mQueue(queueCapacity)
+			{ }
+
+			BoundedQueue<LeapQueuedEvent> mQueue;
+
+			/** Bitmask of LeapQueuedEventType values that have been subscribed to on this channel. */
+			std::atomic<UINT32> mSubscribedTypes{ 0 };
+
+			Event<void(const LEAP_CONNECTION_EVENT*)> onConnection;
+			Event<void(const LEAP_CONNECTION_LOST_EVENT*)> onConnectionLost;
+			Event<void(const LEAP_DEVICE_EVENT*)> onDevice;
+			Event<void(const LEAP_DEVICE_EVENT*)> onDeviceLost;
+			Event<void(const LEAP_DEVICE_FAILURE_EVENT*)> onDeviceFailure;
+			Event<void(const LEAP_DEVICE_STATUS_CHANGE_EVENT*)> onDeviceStatusChange;
+			Event<void(const LEAP_DROPPED_FRAME_EVENT*)> onDroppedFrame;
+			Event<void(const UINT32)> onPolicy;
+			Event<void(const LeapFrame*)> onFrame;
+
+			/** Scratch frame queued frames are read into on delivery. Only touched by the consumer. */
+			LeapFrameAlloc mFrame;
+
+			std::atomic<UINT64> mNumQueued{ 0 };
+			std::atomic<UINT64> mNumOverflowed{ 0 };
+			std::atomic<UINT64> mNumDelivered{ 0 };
+			std::atomic<UINT64> mNumExpired{ 0 };
+			std::atomic<UINT64> mTotalLatency{ 0 };
+			std::atomic<UINT64> mMaxLatency{ 0 };
+		};
+
+		/** Returns the channel of a queued delivery policy and marks @p type as subscribed on it. */
+		Channel& subscribe(LeapDeliveryPolicy policy, LeapQueuedEventType type);
+
+		/** Pops and delivers every event in the queue of @p channel. Must only be called from its consumer thread. */
+		void dispatch(Channel& channel);
+
+		/** Delivers a single event to the subscribers of @p channel. */
+		void deliver(Channel& channel, const LeapQueuedEvent& event);
+
+		/** Drains the worker channel. Runs on the TaskScheduler. */
+		void runWorker();
+
+		const LeapFrameHistory& mFrames;
+
+		Channel mMainThread;
+		Channel mWorker;
+
+		/** True from the moment a worker task is scheduled until it finds the worker queue empty. */
+		std::atomic<bool> mWorkerScheduled{ false };
+
+		/** The most recently scheduled worker task. Only assigned from the message pump thread. */
+		SPtr<Task> mWorkerTask;
+	};
+
+	/** @} */
+}
\ No newline at end of file
@@ -8,12 +8,18 @@ namespace bs
 	template <typename A>
 	const LeapFrame* LeapFrameAllocT<A>::get() const
 	{
+		if (mSize == 0)
+			return NULL;
+
 		return reinterpret_cast<const LeapFrame*>(mAlloc.data());
 	}
 
 	template <typename A>
 	LeapFrame* LeapFrameAllocT<A>::get()
 	{
+		if (mSize == 0)
+			return NULL;
+
 		return reinterpret_cast<LeapFrame*>(mAlloc.data());
 	}
 
@@ -28,18 +34,17 @@ namespace bs
 		data += sizeof(LeapFrame);
 		get()->mHands = reinterpret_cast<LeapHand*>(data);
 
-		for (UINT32 i = 0; i < trackingEvent->nHands; ++i)
-		{
-			std::memcpy(data, trackingEvent->pHands + i, sizeof(LeapHand));
-			data += sizeof(LeapHand);
-		}
+		// Hands are contiguous in the source as well, so they can be copied in one go
+		if (trackingEvent->nHands > 0)
+			std::memcpy(data, trackingEvent->pHands, trackingEvent->nHands * sizeof(LeapHand));
 	}
 
 	template <typename A>
 	void LeapFrameAllocT<A>::resize(size_t size)
 	{
-		mAlloc.clear();
-		mAlloc.resize(size);
+		// Every user overwrites the frame right after resizing, so there is no need to clear it
+		reserve(size);
+		mSize = size;
 	}
 
 	template <typename A>
@@ -48,6 +53,19 @@ namespace bs
 		resize(_sizeBytesNumberOfHands(nHands));
 	}
 
+	template <typename A>
+	void LeapFrameAllocT<A>::reserve(size_t size)
+	{
+		if (size > mAlloc.size())
+			mAlloc.resize(size);
+	}
+
+	template <typename A>
+	void LeapFrameAllocT<A>::reserveNumberOfHands(UINT32 nHands)
+	{
+		reserve(_sizeBytesNumberOfHands(nHands));
+	}
+
 	template <typename A>
 	LeapFrameAllocT<A>& LeapFrameAllocT<A>::operator=(const LeapFrameAllocT& other)
 	{
@@ -60,6 +78,12 @@ namespace bs
 	template <typename A>
 	void LeapFrameAllocT<A>::_copy(const LeapFrameAllocT& other)
 	{
+		if (other.mSize == 0)
+		{
+			mSize = 0;
+			return;
+		}
+
 		copyFrom(reinterpret_cast<const LEAP_TRACKING_EVENT*>(other.get()));
 	}
 
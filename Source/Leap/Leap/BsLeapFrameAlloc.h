@@ -13,6 +13,9 @@ namespace bs
 
 	 /**
 	 * Class representing a memory buffer used when copying LeapFrame from LeapC.
+	 *
+	 * The buffer only ever grows. Once it has been sized for the largest frame it needs to hold, copying or resizing
+	 * frames no longer allocates. Use reserveNumberOfHands() to size it up front.
 	 */
 	template <typename A = StdAlloc<UINT8>>
 	class LeapFrameAllocT
@@ -21,21 +24,33 @@ namespace bs
 		LeapFrameAllocT() = default;
 		LeapFrameAllocT(const LeapFrameAllocT&) = delete;
 
-		/** Returns the LeapFrame. */
+		/** Returns the LeapFrame, or null if no frame was stored yet. */
 		const LeapFrame* get() const;
 
-		/** Returns the LeapFrame. */
+		/** Returns the LeapFrame, or null if no frame was stored yet. */
 		LeapFrame* get();
 
 		/** Updates the LeapFrame data with the provided LEAP_TRACKING_EVENT. */
 		void copyFrom(const LEAP_TRACKING_EVENT* trackingEvent);
 
-		/** Allocates memory needed to save the LeapFrame data. */
+		/**
+		 * Sets the number of bytes of LeapFrame data held by the buffer, growing it if needed. Existing contents are not
+		 * cleared.
+		 */
 		void resize(size_t size);
 
-		/** Allocates memory needed to save the LeapFrame data. */
+		/** Sets the size of the buffer to the size of a LeapFrame with @p nHands hands. */
 		void resizeNumberOfHands(UINT32 nHands);
 
+		/** Grows the buffer so it can hold @p size bytes without allocating, without changing the frame size. */
+		void reserve(size_t size);
+
+		/** Grows the buffer so it can hold a LeapFrame with @p nHands hands without allocating. */
+		void reserveNumberOfHands(UINT32 nHands);
+
+		/** Returns the number of bytes of LeapFrame data held by the buffer. */
+		size_t size() const { return mSize; }
+
 		/** Copy assignment. */
 		LeapFrameAllocT& operator=(const LeapFrameAllocT& other);
 
@@ -46,8 +61,11 @@ namespace bs
 		size_t _sizeBytesNumberOfHands(UINT32 nHands) const;
 
 	private:
-		/** Memory buffer for saving LeapFrame data. */
+		/** Memory buffer for saving LeapFrame data. Its size is the capacity, not the size of the frame. */
 		Vector<UINT8, A> mAlloc;
+
+		/** Number of bytes of mAlloc used by the current frame. */
+		size_t mSize = 0;
 	};
 
 	/** LeapFrameAlloc with default allocator. */
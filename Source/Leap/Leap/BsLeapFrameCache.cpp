@@ -0,0 +1,57 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapFrameCache.h"
+
+namespace bs
+{
+	bool LeapFrameCache::find(UINT64 tick, INT64 timestamp, INT64 sourceTimestamp, LeapFrameAlloc& toFill)
+	{
+		ScopedSpinLock lock(mLock);
+
+		for (auto& entry : mEntries)
+		{
+			if (entry.mIsValid && entry.mTick == tick && entry.mTimestamp == timestamp &&
+				entry.mSourceTimestamp == sourceTimestamp)
+			{
+				toFill = entry.mFrame;
+				mNumHits.fetch_add(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+
+		mNumMisses.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	void LeapFrameCache::store(UINT64 tick, INT64 timestamp, INT64 sourceTimestamp, const LeapFrameAlloc& frame)
+	{
+		ScopedSpinLock lock(mLock);
+
+		// Entries are written in order, so the next one is always the oldest
+		Entry& entry = mEntries[mNextEntry];
+		mNextEntry = (mNextEntry + 1) % CAPACITY;
+
+		entry.mIsValid = true;
+		entry.mTick = tick;
+		entry.mTimestamp = timestamp;
+		entry.mSourceTimestamp = sourceTimestamp;
+		entry.mFrame = frame;
+	}
+
+	void LeapFrameCache::reserveNumberOfHands(UINT32 nHands)
+	{
+		ScopedSpinLock lock(mLock);
+
+		for (auto& entry : mEntries)
+			entry.mFrame.reserveNumberOfHands(nHands);
+	}
+
+	void LeapFrameCache::clear()
+	{
+		ScopedSpinLock lock(mLock);
+
+		for (auto& entry : mEntries)
+			entry.mIsValid = false;
+	}
+}
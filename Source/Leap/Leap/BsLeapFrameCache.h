@@ -0,0 +1,78 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+#include "Leap/BsLeapFrameAlloc.h"
+#include "Threading/BsSpinLock.h"
+
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	/**
+	 * Small cache of untransformed frames computed for a time during a tick, usually an engine frame. Lets several
+	 * callers asking for the same time during the same tick share a single interpolation, each of them only paying for
+	 * a copy of the result.
+	 *
+	 * Entries are only ever hit during the tick they were stored in, so the cache needs no explicit invalidation. Its
+	 * buffers are sized up front, storing and finding frames never allocates. Can be used from any thread.
+	 */
+	class LeapFrameCache
+	{
+	public:
+		LeapFrameCache() = default;
+		LeapFrameCache(const LeapFrameCache&) = delete;
+
+		/**
+		 * Copies the frame stored for @p timestamp and @p sourceTimestamp during @p tick into @p toFill. Returns false
+		 * if there is no such frame.
+		 */
+		bool find(UINT64 tick, INT64 timestamp, INT64 sourceTimestamp, LeapFrameAlloc& toFill);
+
+		/** Stores a copy of the frame computed for @p timestamp and @p sourceTimestamp during @p tick. */
+		void store(UINT64 tick, INT64 timestamp, INT64 sourceTimestamp, const LeapFrameAlloc& frame);
+
+		/** Grows every entry so it can hold @p nHands hands without allocating. */
+		void reserveNumberOfHands(UINT32 nHands);
+
+		/** Drops every entry. */
+		void clear();
+
+		/** Returns how many times find() returned a frame. */
+		UINT64 getNumHits() const { return mNumHits.load(std::memory_order_relaxed); }
+
+		/** Returns how many times find() returned no frame. */
+		UINT64 getNumMisses() const { return mNumMisses.load(std::memory_order_relaxed); }
+
+	public:
+		/**
+		 * Number of frames kept. Covers an update and a few fixed update sub-steps per tick, older entries are replaced
+		 * first.
+		 */
+		static constexpr UINT32 CAPACITY = 8;
+
+	private:
+		struct Entry
+		{
+			bool mIsValid = false;
+			UINT64 mTick = 0;
+			INT64 mTimestamp = 0;
+			INT64 mSourceTimestamp = 0;
+			LeapFrameAlloc mFrame;
+		};
+
+		Entry mEntries[CAPACITY];
+		UINT32 mNextEntry = 0;
+		SpinLock mLock;
+
+		std::atomic<UINT64> mNumHits{ 0 };
+		std::atomic<UINT64> mNumMisses{ 0 };
+	};
+
+	/** @} */
+}
@@ -0,0 +1,181 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapFrameHistory.h"
+
+namespace bs
+{
+	LeapFrameHistory::LeapFrameHistory(UINT32 capacity, UINT32 maxHands)
+		: mSlots(capacity), mHands(capacity * maxHands), mCapacity(capacity), mMaxHands(maxHands)
+	{
+		assert(capacity > 0);
+
+		for (UINT32 i = 0; i < capacity; i++)
+		{
+			std::memset(&mSlots[i].mFrame, 0, sizeof(LeapFrame));
+			mSlots[i].mFrame.mHands = mHands.data() + i * maxHands;
+		}
+	}
+
+	UINT32 LeapFrameHistory::size() const
+	{
+		UINT64 written = mWritten.load(std::memory_order_acquire);
+		return (UINT32)std::min(written, (UINT64)mCapacity);
+	}
+
+	UINT64 LeapFrameHistory::push(const LeapFrame& frame, UINT32 gapBefore)
+	{
+		UINT64 serial = mWritten.load(std::memory_order_relaxed);
+		Slot& slot = mSlots[serial % mCapacity];
+
+		UINT32 sequence = slot.mSequence.load(std::memory_order_relaxed);
+		slot.mSequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		UINT32 numHands = std::min(frame.mNumberOfHands, mMaxHands);
+		LeapHand* hands = slot.mFrame.mHands;
+
+		slot.mSerial = serial;
+		slot.mGapBefore = gapBefore;
+		std::memcpy(&slot.mFrame, &frame, sizeof(LeapFrame));
+		slot.mFrame.mNumberOfHands = numHands;
+		slot.mFrame.mHands = hands;
+
+		if (numHands > 0)
+			std::memcpy(hands, frame.mHands, numHands * sizeof(LeapHand));
+
+		slot.mSequence.store(sequence + 2, std::memory_order_release);
+		mWritten.store(serial + 1, std::memory_order_release);
+
+		return serial;
+	}
+
+	template<class S, class F>
+	bool LeapFrameHistory::readSlot(S select, F copy) const
+	{
+		while (true)
+		{
+			UINT64 written = mWritten.load(std::memory_order_acquire);
+
+			UINT64 serial;
+			if (!select(written, serial))
+				return false;
+
+			const Slot& slot = mSlots[serial % mCapacity];
+
+			UINT32 sequenceBegin = slot.mSequence.load(std::memory_order_acquire);
+			if ((sequenceBegin & 1) == 0)
+			{
+				UINT64 slotSerial = slot.mSerial;
+				copy(slot);
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+				UINT32 sequenceEnd = slot.mSequence.load(std::memory_order_relaxed);
+
+				// The serial check catches a slot that was already recycled for a newer frame before we started reading
+				if (sequenceBegin == sequenceEnd && slotSerial == serial)
+					return true;
+			}
+
+			mReadRetries.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void LeapFrameHistory::copyFrame(const Slot& slot, LeapFrameAlloc& out) const
+	{
+		// The slot may be torn if a write is in progress, never trust the hand count beyond the slot size
+		UINT32 numHands = std::min(slot.mFrame.mNumberOfHands, mMaxHands);
+		const LeapHand* hands = mHands.data() + (&slot - mSlots.data()) * mMaxHands;
+
+		out.resizeNumberOfHands(numHands);
+
+		LeapFrame* frame = out.get();
+		LeapHand* frameHands = reinterpret_cast<LeapHand*>(reinterpret_cast<UINT8*>(frame) + sizeof(LeapFrame));
+
+		std::memcpy(frame, &slot.mFrame, sizeof(LeapFrame));
+		frame->mNumberOfHands = numHands;
+		frame->mHands = frameHands;
+
+		if (numHands > 0)
+			std::memcpy(frameHands, hands, numHands * sizeof(LeapHand));
+	}
+
+	bool LeapFrameHistory::read(UINT32 history, LeapFrameAlloc& out) const
+	{
+		return readSlot(selectHistory(history), [&](const Slot& slot) { copyFrame(slot, out); });
+	}
+
+	bool LeapFrameHistory::readSerial(UINT64 serial, LeapFrameAlloc& out) const
+	{
+		return readSlot(selectSerial(serial), [&](const Slot& slot) { copyFrame(slot, out); });
+	}
+
+	INT64 LeapFrameHistory::readTimestamp(UINT32 history) const
+	{
+		INT64 timestamp = 0;
+		bool success = readSlot(selectHistory(history), [&](const Slot& slot) { timestamp = slot.mFrame.mInfo.timestamp; });
+
+		return success ? timestamp : 0;
+	}
+
+	bool LeapFrameHistory::readBracket(INT64 timestamp, LeapFrameAlloc& before, LeapFrameAlloc& after) const
+	{
+		INT64 slotTimestamp = 0;
+		auto copyTimestamp = [&](const Slot& slot) { slotTimestamp = slot.mFrame.mInfo.timestamp; };
+
+		// Serials stay valid for a whole search, unless the writer laps the oldest frames during it, in which case the
+		// search restarts on the newer range
+		while (true)
+		{
+			UINT64 written = mWritten.load(std::memory_order_acquire);
+			UINT64 count = std::min(written, (UINT64)mCapacity);
+			if (count < 2)
+				return false;
+
+			UINT64 low = written - count;
+			UINT64 high = written - 1;
+
+			if (!readSlot(selectSerial(low), copyTimestamp))
+				continue;
+
+			if (timestamp < slotTimestamp)
+				return false;
+
+			if (!readSlot(selectSerial(high), copyTimestamp))
+				continue;
+
+			if (timestamp > slotTimestamp)
+				return false;
+
+			bool lapped = false;
+			while (high - low > 1)
+			{
+				UINT64 middle = low + (high - low) / 2;
+				if (!readSlot(selectSerial(middle), copyTimestamp))
+				{
+					lapped = true;
+					break;
+				}
+
+				if (slotTimestamp <= timestamp)
+					low = middle;
+				else
+					high = middle;
+			}
+
+			if (lapped)
+				continue;
+
+			if (readSerial(low, before) && readSerial(high, after))
+				return true;
+		}
+	}
+
+	UINT32 LeapFrameHistory::readGapBefore(UINT32 history) const
+	{
+		UINT32 gapBefore = 0;
+		bool success = readSlot(selectHistory(history), [&](const Slot& slot) { gapBefore = slot.mGapBefore; });
+
+		return success ? gapBefore : 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+#include "Leap/BsLeapFrame.h"
+#include "Leap/BsLeapFrameAlloc.h"
+
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	/**
+	 * Fixed capacity history of the most recent tracking frames. Written by a single producer (the LeapC message pump
+	 * thread) and read by any number of threads without taking a lock.
+	 *
+	 * Every slot is guarded by a sequence counter. The writer makes the counter odd while it updates the slot and even
+	 * again once it is done. A reader copies the slot and only accepts the copy if the counter was even and unchanged for
+	 * the whole copy, otherwise it retries. The writer never waits for readers.
+	 *
+	 * The history owns a deep copy of every frame. Hand data is stored in slots preallocated for a fixed maximum number
+	 * of hands, so frames stay valid after LeapC reuses its message memory and pushing a frame never allocates. Hands in
+	 * excess of the maximum are dropped.
+	 */
+	class LeapFrameHistory
+	{
+	public:
+		/** Constructs a history able to hold @p capacity frames of up to @p maxHands hands each. */
+		LeapFrameHistory(UINT32 capacity, UINT32 maxHands);
+
+		/** Returns the maximum number of frames stored in the history. */
+		UINT32 getCapacity() const { return mCapacity; }
+
+		/** Returns the maximum number of hands stored per frame. */
+		UINT32 getMaxHands() const { return mMaxHands; }
+
+		/** Returns the number of frames currently stored in the history. */
+		UINT32 size() const;
+
+		/**
+		 * Adds a deep copy of a new frame, overwriting the oldest one once full. Must only be called from the producer
+		 * thread.
+		 *
+		 * @param frame		The frame to add.
+		 * @param gapBefore	Number of tracking frames known to be missing between the previous frame and this one.
+		 * @returns			Serial number of the new frame. Serials start at zero and increase by one with every push.
+		 */
+		UINT64 push(const LeapFrame& frame, UINT32 gapBefore = 0);
+
+		/**
+		 * Copies the frame at the specified history position, 0 being the most recent frame, including its hands.
+		 *
+		 * @param history	The age of the frame to read.
+		 * @param[out] out	Receives a consistent copy of the frame.
+		 * @returns			True if a frame was available at the specified position, false otherwise.
+		 */
+		bool read(UINT32 history, LeapFrameAlloc& out) const;
+
+		/**
+		 * Copies the frame with the specified serial number, as returned by push(), including its hands.
+		 *
+		 * @param serial	The serial number of the frame to read.
+		 * @param[out] out	Receives a consistent copy of the frame.
+		 * @returns			True if the frame is still in the history, false if it was never pushed or was already
+		 *					overwritten.
+		 */
+		bool readSerial(UINT64 serial, LeapFrameAlloc& out) const;
+
+		/** Returns the timestamp of the frame at the specified history position, or 0 if there is no such frame. */
+		INT64 readTimestamp(UINT32 history) const;
+
+		/**
+		 * Finds the two consecutive frames whose timestamps enclose @p timestamp, using a binary search over the history,
+		 * and copies them.
+		 *
+		 * @param timestamp		The time to look up, on the LeapC clock.
+		 * @param[out] before	Receives the newest frame with a timestamp not after @p timestamp.
+		 * @param[out] after	Receives the frame following @p before.
+		 * @returns				True if both frames were found, false if @p timestamp is outside of the time range covered
+		 *						by the history.
+		 */
+		bool readBracket(INT64 timestamp, LeapFrameAlloc& before, LeapFrameAlloc& after) const;
+
+		/**
+		 * Returns the number of tracking frames missing between the frame at the specified history position and the one
+		 * before it, or 0 if there is no such frame. Lets interpolation know when it is bridging a hole in the data.
+		 */
+		UINT32 readGapBefore(UINT32 history) const;
+
+		/** Returns how many times a reader had to retry because the slot it was reading was concurrently rewritten. */
+		UINT64 getReadRetryCount() const { return mReadRetries.load(std::memory_order_relaxed); }
+
+	private:
+		/** Single entry of the history. */
+		struct Slot
+		{
+			std::atomic<UINT32> mSequence{ 0 };
+			UINT64 mSerial = 0;
+			UINT32 mGapBefore = 0;
+			LeapFrame mFrame;
+		};
+
+		/**
+		 * Runs @p copy on the slot holding the frame picked by @p select, retrying until the copy is consistent. @p select
+		 * receives the number of frames written so far and outputs the serial of the frame to read, or returns false if
+		 * there is no such frame.
+		 */
+		template<class S, class F>
+		bool readSlot(S select, F copy) const;
+
+		/** Returns a selector for readSlot() picking the frame at the specified history position. */
+		auto selectHistory(UINT32 history) const
+		{
+			return [this, history](UINT64 written, UINT64& serial)
+			{
+				if (history >= std::min(written, (UINT64)mCapacity))
+					return false;
+
+				serial = written - 1 - history;
+				return true;
+			};
+		}
+
+		/** Returns a selector for readSlot() picking the frame with the specified serial. */
+		auto selectSerial(UINT64 serial) const
+		{
+			return [this, serial](UINT64 written, UINT64& selected)
+			{
+				if (serial >= written || written - serial > mCapacity)
+					return false;
+
+				selected = serial;
+				return true;
+			};
+		}
+
+		/** Deep copies the frame stored in @p slot to @p out. Slot may be torn. */
+		void copyFrame(const Slot& slot, LeapFrameAlloc& out) const;
+
+		Vector<Slot> mSlots;
+		Vector<LeapHand> mHands;
+		UINT32 mCapacity;
+		UINT32 mMaxHands;
+
+		/** Total number of frames ever pushed. The newest frame has the serial mWritten - 1. */
+		std::atomic<UINT64> mWritten{ 0 };
+		mutable std::atomic<UINT64> mReadRetries{ 0 };
+	};
+
+	/** @} */
+}
\ No newline at end of file
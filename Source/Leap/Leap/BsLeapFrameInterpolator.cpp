@@ -0,0 +1,101 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapFrameInterpolator.h"
+#include "Leap/BsLeapFrameHistory.h"
+
+namespace bs
+{
+	bool LeapFrameInterpolator::reset(const LeapFrameHistory& history, INT64 timestamp)
+	{
+		mIsValid = history.readBracket(timestamp, mFrom, mTo);
+		if (!mIsValid)
+			return false;
+
+		const LeapFrame* from = mFrom.get();
+		const LeapFrame* to = mTo.get();
+
+		matchHands(from, to, mFromMatches);
+		matchHands(to, from, mToMatches);
+
+		// Sized for every hand so indexing stays simple, unmatched hands leave their entries unused
+		mSlerps.resize(from->mNumberOfHands * LeapFrameUtility::NUM_HAND_ROTATIONS);
+		for (UINT32 i = 0; i < from->mNumberOfHands; ++i)
+		{
+			INT32 match = mFromMatches[i];
+			if (match >= 0)
+			{
+				LeapFrameUtility::prepareInterpolation(from->mHands[i], to->mHands[match],
+					&mSlerps[i * LeapFrameUtility::NUM_HAND_ROTATIONS]);
+			}
+		}
+
+		return true;
+	}
+
+	bool LeapFrameInterpolator::contains(INT64 timestamp) const
+	{
+		if (!mIsValid)
+			return false;
+
+		return timestamp >= mFrom.get()->mInfo.timestamp && timestamp <= mTo.get()->mInfo.timestamp;
+	}
+
+	void LeapFrameInterpolator::evaluate(INT64 timestamp, LeapFrameAlloc& toFill) const
+	{
+		assert(contains(timestamp));
+
+		const LeapFrame* from = mFrom.get();
+		const LeapFrame* to = mTo.get();
+
+		INT64 duration = to->mInfo.timestamp - from->mInfo.timestamp;
+		float t = duration > 0 ? (float)((double)(timestamp - from->mInfo.timestamp) / duration) : 1.0f;
+
+		bool isFromNearest = t < 0.5f;
+		const LeapFrame* nearest = isFromNearest ? from : to;
+		const Vector<INT32>& matches = isFromNearest ? mFromMatches : mToMatches;
+
+		toFill.resizeNumberOfHands(nearest->mNumberOfHands);
+
+		LeapFrame* out = toFill.get();
+		LeapHand* hands = reinterpret_cast<LeapHand*>(reinterpret_cast<UINT8*>(out) + sizeof(LeapFrame));
+
+		*out = *nearest;
+		out->mHands = hands;
+		out->mInfo.timestamp = timestamp;
+		out->mFramerate = from->mFramerate + (to->mFramerate - from->mFramerate) * t;
+
+		for (UINT32 i = 0; i < nearest->mNumberOfHands; ++i)
+		{
+			INT32 match = matches[i];
+			if (match < 0)
+			{
+				hands[i] = nearest->mHands[i];
+				continue;
+			}
+
+			UINT32 fromIndex = isFromNearest ? i : (UINT32)match;
+			UINT32 toIndex = isFromNearest ? (UINT32)match : i;
+
+			LeapFrameUtility::interpolate(from->mHands[fromIndex], to->mHands[toIndex],
+				&mSlerps[fromIndex * LeapFrameUtility::NUM_HAND_ROTATIONS], t, hands[i]);
+		}
+	}
+
+	void LeapFrameInterpolator::matchHands(const LeapFrame* frame, const LeapFrame* other, Vector<INT32>& matches)
+	{
+		matches.resize(frame->mNumberOfHands);
+		for (UINT32 i = 0; i < frame->mNumberOfHands; ++i)
+		{
+			matches[i] = -1;
+			for (UINT32 j = 0; j < other->mNumberOfHands; ++j)
+			{
+				if (other->mHands[j].mId == frame->mHands[i].mId)
+				{
+					matches[i] = (INT32)j;
+					break;
+				}
+			}
+		}
+	}
+}
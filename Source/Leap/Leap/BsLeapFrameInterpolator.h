@@ -0,0 +1,58 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapFrameUtility.h"
+#include "Leap/BsLeapFrameAlloc.h"
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	class LeapFrameHistory;
+
+	/**
+	 * Interpolates repeatedly between the same two history frames. Reading the frames, matching their hands and preparing
+	 * the orientations for slerp is done once in reset(), so every evaluate() only pays for the blend itself. Fixed
+	 * update sub-steps of a single render frame usually fall between the same two tracking frames, which makes
+	 * generating several of them barely more expensive than generating one.
+	 */
+	class LeapFrameInterpolator
+	{
+	public:
+		/**
+		 * Reads the two history frames enclosing @p timestamp and prepares the interpolation between them.
+		 *
+		 * @returns False if the history doesn't cover @p timestamp, in which case the interpolator is left empty.
+		 */
+		bool reset(const LeapFrameHistory& history, INT64 timestamp);
+
+		/** Empties the interpolator. */
+		void clear() { mIsValid = false; }
+
+		/** Returns true if the interpolator holds two frames enclosing @p timestamp. */
+		bool contains(INT64 timestamp) const;
+
+		/** Fills @p toFill with the frame at @p timestamp. The timestamp must be contained by the interpolator. */
+		void evaluate(INT64 timestamp, LeapFrameAlloc& toFill) const;
+
+	private:
+		/** Matches the hands of @p frame with those of @p other by id, -1 meaning no match. */
+		static void matchHands(const LeapFrame* frame, const LeapFrame* other, Vector<INT32>& matches);
+
+		LeapFrameAlloc mFrom;
+		LeapFrameAlloc mTo;
+		bool mIsValid = false;
+
+		/** Index of the matching hand in the other frame for each hand of mFrom and mTo, or -1. */
+		Vector<INT32> mFromMatches;
+		Vector<INT32> mToMatches;
+
+		/** LeapFrameUtility::NUM_HAND_ROTATIONS entries for each hand of mFrom that has a match. */
+		Vector<LeapSlerpParams> mSlerps;
+	};
+
+	/** @} */
+}
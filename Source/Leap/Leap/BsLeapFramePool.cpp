@@ -0,0 +1,159 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapFramePool.h"
+
+namespace bs
+{
+	/**
+	 * Held while a snapshot is handed back to its pool and while a pool is destroyed, so that a release can't pick the
+	 * pool just before it is destroyed. Only taken on the last release of a snapshot.
+	 */
+	static SpinLock sPoolLifetimeLock;
+
+	LeapFrameRef::LeapFrameRef(LeapFrameSnapshot* snapshot)
+		: mSnapshot(snapshot)
+	{
+		mSnapshot->mRefCount.store(1, std::memory_order_relaxed);
+	}
+
+	LeapFrameRef::LeapFrameRef(const LeapFrameRef& other)
+		: mSnapshot(other.mSnapshot)
+	{
+		if (mSnapshot != nullptr)
+			mSnapshot->mRefCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	LeapFrameRef::LeapFrameRef(LeapFrameRef&& other) noexcept
+		: mSnapshot(other.mSnapshot)
+	{
+		other.mSnapshot = nullptr;
+	}
+
+	LeapFrameRef::~LeapFrameRef()
+	{
+		release();
+	}
+
+	LeapFrameRef& LeapFrameRef::operator=(const LeapFrameRef& other)
+	{
+		if (mSnapshot != other.mSnapshot)
+		{
+			if (other.mSnapshot != nullptr)
+				other.mSnapshot->mRefCount.fetch_add(1, std::memory_order_relaxed);
+
+			release();
+			mSnapshot = other.mSnapshot;
+		}
+
+		return *this;
+	}
+
+	LeapFrameRef& LeapFrameRef::operator=(LeapFrameRef&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			mSnapshot = other.mSnapshot;
+			other.mSnapshot = nullptr;
+		}
+
+		return *this;
+	}
+
+	void LeapFrameRef::release()
+	{
+		if (mSnapshot == nullptr)
+			return;
+
+		if (mSnapshot->mRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			LeapFramePool::release(mSnapshot);
+
+		mSnapshot = nullptr;
+	}
+
+	LeapFrameAlloc& LeapFrameRef::_getWritable()
+	{
+		assert(isUnique());
+		return mSnapshot->mFrame;
+	}
+
+	LeapFramePool::~LeapFramePool()
+	{
+		ScopedSpinLock lifetimeLock(sPoolLifetimeLock);
+		ScopedSpinLock lock(mLock);
+
+		// A snapshot off the free list may have just lost its last reference, with its release waiting for the lock. It
+		// is left for that release, or the ones still to come, to free.
+		for (auto& snapshot : mSnapshots)
+			snapshot->mPool = nullptr;
+
+		while (mFreeList != nullptr)
+		{
+			LeapFrameSnapshot* snapshot = mFreeList;
+			mFreeList = snapshot->mNextFree;
+
+			bs_delete(snapshot);
+		}
+	}
+
+	LeapFrameRef LeapFramePool::acquire()
+	{
+		LeapFrameSnapshot* snapshot;
+		UINT32 numReservedHands;
+		{
+			ScopedSpinLock lock(mLock);
+
+			snapshot = mFreeList;
+			if (snapshot != nullptr)
+				mFreeList = snapshot->mNextFree;
+			else
+			{
+				snapshot = bs_new<LeapFrameSnapshot>();
+				snapshot->mPool = this;
+				mSnapshots.push_back(snapshot);
+			}
+
+			numReservedHands = mNumReservedHands;
+		}
+
+		// Also grows snapshots that were in use when the reservation was raised. Nobody else can see the snapshot yet.
+		snapshot->mFrame.reserveNumberOfHands(numReservedHands);
+		snapshot->mNextFree = nullptr;
+		return LeapFrameRef(snapshot);
+	}
+
+	void LeapFramePool::reserveNumberOfHands(UINT32 nHands)
+	{
+		ScopedSpinLock lock(mLock);
+
+		mNumReservedHands = std::max(mNumReservedHands, nHands);
+
+		// Snapshots in use can't be touched, they are reserved when they are acquired again
+		for (LeapFrameSnapshot* snapshot = mFreeList; snapshot != nullptr; snapshot = snapshot->mNextFree)
+			snapshot->mFrame.reserveNumberOfHands(mNumReservedHands);
+	}
+
+	void LeapFramePool::release(LeapFrameSnapshot* snapshot)
+	{
+		LeapFramePool* pool;
+		{
+			ScopedSpinLock lifetimeLock(sPoolLifetimeLock);
+
+			pool = snapshot->mPool;
+			if (pool != nullptr)
+				pool->recycle(snapshot);
+		}
+
+		if (pool == nullptr)
+			bs_delete(snapshot);
+	}
+
+	void LeapFramePool::recycle(LeapFrameSnapshot* snapshot)
+	{
+		ScopedSpinLock lock(mLock);
+
+		snapshot->mNextFree = mFreeList;
+		mFreeList = snapshot;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+#include "Leap/BsLeapFrameAlloc.h"
+#include "Threading/BsSpinLock.h"
+
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	class LeapFramePool;
+
+	/** Pooled frame buffer shared through LeapFrameRef. For internal use only. */
+	struct LeapFrameSnapshot
+	{
+		std::atomic<UINT32> mRefCount{ 0 };
+
+		/**
+		 * Pool the snapshot returns to once unreferenced, or null if the pool was destroyed in the meantime. Only accessed
+		 * under the lock shared by the last release of every snapshot and the destruction of every pool.
+		 */
+		LeapFramePool* mPool = nullptr;
+
+		LeapFrameAlloc mFrame;
+		LeapFrameSnapshot* mNextFree = nullptr;
+	};
+
+	/**
+	 * Reference to an immutable frame snapshot obtained from a LeapFramePool. Copying a reference only increments a
+	 * reference count. The frame stays valid and unchanged for as long as any reference to it exists, after which its
+	 * buffer goes back to the pool. References can be copied and released from any thread.
+	 */
+	class LeapFrameRef
+	{
+	public:
+		LeapFrameRef() = default;
+		LeapFrameRef(const LeapFrameRef& other);
+		LeapFrameRef(LeapFrameRef&& other) noexcept;
+		~LeapFrameRef();
+
+		LeapFrameRef& operator=(const LeapFrameRef& other);
+		LeapFrameRef& operator=(LeapFrameRef&& other) noexcept;
+
+		/** Returns the frame, or null if the reference is empty or the snapshot holds no frame. */
+		const LeapFrame* get() const { return mSnapshot != nullptr ? mSnapshot->mFrame.get() : NULL; }
+
+		/** Returns the frame. Must not be called on an empty reference. */
+		const LeapFrame* operator->() const { return get(); }
+
+		/** Returns true if this is the only reference to the snapshot. */
+		bool isUnique() const { return mSnapshot != nullptr && mSnapshot->mRefCount.load(std::memory_order_acquire) == 1; }
+
+		/** Drops the reference, leaving this object empty. */
+		void release();
+
+		/**
+		 * Returns the buffer of the snapshot so it can be filled. Only allowed on a unique reference, before it is shared,
+		 * which is what keeps shared snapshots immutable. For internal use only.
+		 */
+		LeapFrameAlloc& _getWritable();
+
+	private:
+		friend class LeapFramePool;
+
+		explicit LeapFrameRef(LeapFrameSnapshot* snapshot);
+
+		LeapFrameSnapshot* mSnapshot = nullptr;
+	};
+
+	/**
+	 * Pool of frame snapshots. Snapshots are recycled once their last LeapFrameRef is released, so publishing a new
+	 * frame doesn't allocate once the pool holds as many snapshots as are referenced at the same time.
+	 *
+	 * If the pool is destroyed while references are still held, those snapshots are freed by their last release instead.
+	 */
+	class LeapFramePool
+	{
+	public:
+		LeapFramePool() = default;
+		LeapFramePool(const LeapFramePool&) = delete;
+		~LeapFramePool();
+
+		/** Returns a unique reference to an unused snapshot, to be filled through LeapFrameRef::_getWritable(). */
+		LeapFrameRef acquire();
+
+		/** Grows every current and future snapshot buffer so it can hold @p nHands hands without allocating. */
+		void reserveNumberOfHands(UINT32 nHands);
+
+		/** Returns the number of snapshots created by the pool. */
+		UINT32 getNumSnapshots() const { return (UINT32)mSnapshots.size(); }
+
+	private:
+		friend class LeapFrameRef;
+
+		/**
+		 * Returns a snapshot whose last reference was released to its pool, or frees it if the pool is gone. Serialized
+		 * with the destruction of pools, so the pool can't be destroyed halfway through.
+		 */
+		static void release(LeapFrameSnapshot* snapshot);
+
+		/** Puts an unreferenced snapshot back on the free list. */
+		void recycle(LeapFrameSnapshot* snapshot);
+
+		Vector<LeapFrameSnapshot*> mSnapshots;
+		LeapFrameSnapshot* mFreeList = nullptr;
+		UINT32 mNumReservedHands = 0;
+		SpinLock mLock;
+	};
+
+	/** @} */
+}
\ No newline at end of file
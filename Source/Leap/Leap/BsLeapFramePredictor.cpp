@@ -0,0 +1,328 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapFramePredictor.h"
+#include "Leap/BsLeapFrameHistory.h"
+
+namespace bs
+{
+	/** Prediction error, in millimeters, at which the confidence in a joint falls to one half. */
+	static constexpr float ERROR_SCALE = 5.0f;
+
+	/** Weight of the newest prediction error in the confidence of a joint. */
+	static constexpr float CONFIDENCE_BLEND = 0.2f;
+
+	/** Largest rotation a joint is extrapolated by, in radians. */
+	static constexpr float MAX_ROTATION = Math::PI * 0.25f;
+
+	LeapFramePredictor::LeapFramePredictor(INT64 maxHorizon)
+		: mMaxHorizon(maxHorizon)
+	{ }
+
+	void LeapFramePredictor::update(const LeapFrameHistory& history)
+	{
+		// Older frames would be pushed out of the samples by the newer ones anyway
+		INT64 newest = getNewestTimestamp();
+		UINT32 numNewFrames = 0;
+		while (numNewFrames < NUM_SAMPLES)
+		{
+			INT64 timestamp = history.readTimestamp(numNewFrames);
+			if (timestamp == 0 || timestamp <= newest)
+				break;
+
+			numNewFrames++;
+		}
+
+		// A frame pushed in the meantime shifts the positions, the frames read are then just not the newest ones
+		for (UINT32 i = numNewFrames; i-- > 0;)
+		{
+			if (history.read(i, mReadFrame))
+				addFrame(*mReadFrame.get());
+		}
+	}
+
+	void LeapFramePredictor::addFrame(const LeapFrame& frame)
+	{
+		INT64 timestamp = frame.mInfo.timestamp;
+		if (mHasFrame && timestamp <= mNewestFrame.mInfo.timestamp)
+			return;
+
+		// Hands missing from the frame are lost, LeapC gives them a new id once they are tracked again
+		mNextHands.resize(frame.mNumberOfHands);
+		for (UINT32 i = 0; i < frame.mNumberOfHands; ++i)
+		{
+			const LeapHand& hand = frame.mHands[i];
+
+			HandState& state = mNextHands[i];
+			state.mId = hand.mId;
+			state.mNumSamples = 0;
+
+			for (auto& entry : mHands)
+			{
+				if (entry.mId == hand.mId && entry.mNumSamples > 0)
+				{
+					state = entry;
+					break;
+				}
+			}
+
+			if (state.mNumSamples == 0)
+				std::fill(std::begin(state.mConfidence), std::end(state.mConfidence), 0.0f);
+
+			addSample(state, timestamp, hand);
+		}
+
+		std::swap(mHands, mNextHands);
+
+		mNewestFrame = frame;
+		mNewestFrame.mHands = nullptr;
+		mHasFrame = true;
+	}
+
+	void LeapFramePredictor::clear()
+	{
+		mHands.clear();
+		mHasFrame = false;
+	}
+
+	bool LeapFramePredictor::predict(INT64 timestamp, LeapFrameAlloc& toFill) const
+	{
+		if (!mHasFrame)
+			return false;
+
+		UINT32 numHands = (UINT32)mHands.size();
+		toFill.resizeNumberOfHands(numHands);
+
+		LeapFrame* out = toFill.get();
+		LeapHand* hands = reinterpret_cast<LeapHand*>(reinterpret_cast<UINT8*>(out) + sizeof(LeapFrame));
+
+		*out = mNewestFrame;
+		out->mHands = hands;
+		out->mNumberOfHands = numHands;
+
+		// Tracking was lost, hold the newest frame instead of extrapolating ever further from it
+		INT64 horizon = std::max(timestamp - mNewestFrame.mInfo.timestamp, (INT64)0);
+		if (horizon > mMaxHorizon)
+		{
+			for (UINT32 i = 0; i < numHands; ++i)
+				hands[i] = mHands[i].mSamples[NUM_SAMPLES - 1];
+
+			return true;
+		}
+
+		out->mInfo.timestamp = mNewestFrame.mInfo.timestamp + horizon;
+		for (UINT32 i = 0; i < numHands; ++i)
+			predictHand(mHands[i], horizon, hands[i]);
+
+		return true;
+	}
+
+	float LeapFramePredictor::getJointConfidence(UINT32 hand, UINT32 joint, INT64 timestamp) const
+	{
+		assert(joint < NUM_JOINTS);
+
+		if (!mHasFrame || hand >= mHands.size())
+			return 0.0f;
+
+		INT64 horizon = std::max(timestamp - mNewestFrame.mInfo.timestamp, (INT64)0);
+		return mHands[hand].mConfidence[joint] * getHorizonFalloff(horizon);
+	}
+
+	void LeapFramePredictor::addSample(HandState& state, INT64 timestamp, const LeapHand& hand) const
+	{
+		INT64 horizon = state.mNumSamples > 0 ? timestamp - state.mTimestamps[NUM_SAMPLES - 1] : 0;
+
+		// Samples from before a hole in the tracking say nothing about the current motion
+		if (horizon > mMaxHorizon)
+		{
+			state.mNumSamples = 0;
+			std::fill(std::begin(state.mConfidence), std::end(state.mConfidence), 0.0f);
+		}
+
+		// The undamped model is measured, otherwise a low confidence would hide the errors that caused it
+		if (state.mNumSamples >= 2)
+		{
+			const LeapHand& oldest = state.mSamples[NUM_SAMPLES - state.mNumSamples];
+			const LeapHand& previous = state.mSamples[NUM_SAMPLES - 2];
+			const LeapHand& newest = state.mSamples[NUM_SAMPLES - 1];
+
+			SampleWeights weights = getWeights(getDerivatives(state), 1.0f, horizon);
+			for (UINT32 i = 0; i < NUM_JOINTS; ++i)
+			{
+				Vector3 predicted = extrapolate(weights, getJointPosition(oldest, i), getJointPosition(previous, i),
+					getJointPosition(newest, i));
+
+				float error = (predicted - getJointPosition(hand, i)).length();
+				float confidence = ERROR_SCALE / (ERROR_SCALE + error);
+
+				state.mConfidence[i] += (confidence - state.mConfidence[i]) * CONFIDENCE_BLEND;
+			}
+		}
+
+		for (UINT32 i = 1; i < NUM_SAMPLES; ++i)
+		{
+			state.mTimestamps[i - 1] = state.mTimestamps[i];
+			state.mSamples[i - 1] = state.mSamples[i];
+		}
+
+		state.mTimestamps[NUM_SAMPLES - 1] = timestamp;
+		state.mSamples[NUM_SAMPLES - 1] = hand;
+		state.mNumSamples = std::min(state.mNumSamples + 1, NUM_SAMPLES);
+	}
+
+	void LeapFramePredictor::predictHand(const HandState& state, INT64 horizon, LeapHand& out) const
+	{
+		const LeapHand& newest = state.mSamples[NUM_SAMPLES - 1];
+		out = newest;
+
+		if (state.mNumSamples < 2 || horizon == 0)
+			return;
+
+		// With two samples the oldest one is the previous one, with no weight
+		const LeapHand& oldest = state.mSamples[NUM_SAMPLES - state.mNumSamples];
+		const LeapHand& previous = state.mSamples[NUM_SAMPLES - 2];
+
+		Derivatives derivatives = getDerivatives(state);
+		float interval = (float)(state.mTimestamps[NUM_SAMPLES - 1] - state.mTimestamps[NUM_SAMPLES - 2]);
+
+		// Joints ordered as in NUM_JOINTS
+		float confidence = state.mConfidence[0];
+		if (confidence > 0.0f)
+		{
+			SampleWeights weights = getWeights(derivatives, confidence, horizon);
+			float t = 1.0f + confidence * horizon / interval;
+
+			out.mPalm.mPosition = extrapolate(weights, oldest.mPalm.mPosition, previous.mPalm.mPosition,
+				newest.mPalm.mPosition);
+			out.mPalm.mStabilizedPosition = extrapolate(weights, oldest.mPalm.mStabilizedPosition,
+				previous.mPalm.mStabilizedPosition, newest.mPalm.mStabilizedPosition);
+
+			out.mPalm.mOrientation = extrapolate(previous.mPalm.mOrientation, newest.mPalm.mOrientation, t);
+
+			Quaternion rotation = out.mPalm.mOrientation * newest.mPalm.mOrientation.inverse();
+			out.mPalm.mNormal = rotation.rotate(newest.mPalm.mNormal);
+			out.mPalm.mDirection = rotation.rotate(newest.mPalm.mDirection);
+		}
+
+		for (UINT32 i = 0; i < 5; ++i)
+		{
+			for (UINT32 j = 0; j < 4; ++j)
+			{
+				confidence = state.mConfidence[1 + i * 4 + j];
+				if (confidence == 0.0f)
+					continue;
+
+				SampleWeights weights = getWeights(derivatives, confidence, horizon);
+				float t = 1.0f + confidence * horizon / interval;
+
+				predictBone(oldest.mDigits[i].mBones[j], previous.mDigits[i].mBones[j], newest.mDigits[i].mBones[j],
+					weights, t, out.mDigits[i].mBones[j]);
+			}
+		}
+
+		confidence = state.mConfidence[NUM_JOINTS - 1];
+		if (confidence > 0.0f)
+		{
+			SampleWeights weights = getWeights(derivatives, confidence, horizon);
+			float t = 1.0f + confidence * horizon / interval;
+
+			predictBone(oldest.mArm, previous.mArm, newest.mArm, weights, t, out.mArm);
+		}
+	}
+
+	void LeapFramePredictor::predictBone(const LeapBone& oldest, const LeapBone& previous, const LeapBone& newest,
+		const SampleWeights& weights, float t, LeapBone& out)
+	{
+		out.mPrevJoint = extrapolate(weights, oldest.mPrevJoint, previous.mPrevJoint, newest.mPrevJoint);
+		out.mNextJoint = extrapolate(weights, oldest.mNextJoint, previous.mNextJoint, newest.mNextJoint);
+		out.mRotation = extrapolate(previous.mRotation, newest.mRotation, t);
+	}
+
+	float LeapFramePredictor::getHorizonFalloff(INT64 horizon) const
+	{
+		if (horizon > mMaxHorizon)
+			return 0.0f;
+
+		return 1.0f - (float)horizon / (float)mMaxHorizon;
+	}
+
+	LeapFramePredictor::Derivatives LeapFramePredictor::getDerivatives(const HandState& state)
+	{
+		Derivatives output;
+
+		// Backward difference over the last interval
+		double newestInterval = (double)(state.mTimestamps[2] - state.mTimestamps[1]);
+		output.mVelocity[0] = 0.0;
+		output.mVelocity[1] = -1.0 / newestInterval;
+		output.mVelocity[2] = 1.0 / newestInterval;
+
+		output.mAcceleration[0] = 0.0;
+		output.mAcceleration[1] = 0.0;
+		output.mAcceleration[2] = 0.0;
+
+		if (state.mNumSamples < 3)
+			return output;
+
+		// Change of the velocity between the two intervals, over the time between their centers. Handles the uneven
+		// spacing of frames when LeapC drops some.
+		double oldestInterval = (double)(state.mTimestamps[1] - state.mTimestamps[0]);
+		double scale = 2.0 / (oldestInterval + newestInterval);
+
+		output.mAcceleration[0] = scale / oldestInterval;
+		output.mAcceleration[1] = -scale / oldestInterval - scale / newestInterval;
+		output.mAcceleration[2] = scale / newestInterval;
+
+		// Moves the velocity from the center of the last interval to the newest sample
+		for (UINT32 i = 0; i < NUM_SAMPLES; ++i)
+			output.mVelocity[i] += output.mAcceleration[i] * newestInterval * 0.5;
+
+		return output;
+	}
+
+	LeapFramePredictor::SampleWeights LeapFramePredictor::getWeights(const Derivatives& derivatives, float confidence,
+		INT64 horizon)
+	{
+		// The acceleration is damped more than the velocity, as it is what overshoots on sudden stops
+		double velocityScale = confidence * (double)horizon;
+		double accelerationScale = 0.5 * velocityScale * velocityScale;
+
+		SampleWeights output;
+		for (UINT32 i = 0; i < NUM_SAMPLES; ++i)
+		{
+			output.mWeights[i] = (float)(derivatives.mVelocity[i] * velocityScale +
+				derivatives.mAcceleration[i] * accelerationScale);
+		}
+
+		output.mWeights[NUM_SAMPLES - 1] += 1.0f;
+		return output;
+	}
+
+	Vector3 LeapFramePredictor::getJointPosition(const LeapHand& hand, UINT32 joint)
+	{
+		if (joint == 0)
+			return hand.mPalm.mPosition;
+
+		if (joint == NUM_JOINTS - 1)
+			return hand.mArm.mNextJoint;
+
+		UINT32 bone = joint - 1;
+		return hand.mDigits[bone / 4].mBones[bone % 4].mNextJoint;
+	}
+
+	Vector3 LeapFramePredictor::extrapolate(const SampleWeights& weights, const Vector3& oldest, const Vector3& previous,
+		const Vector3& newest)
+	{
+		return oldest * weights.mWeights[0] + previous * weights.mWeights[1] + newest * weights.mWeights[2];
+	}
+
+	Quaternion LeapFramePredictor::extrapolate(const Quaternion& previous, const Quaternion& newest, float t)
+	{
+		LeapSlerpParams params(previous, newest);
+
+		// The angle of the parameters is half the rotation angle
+		if (!params.mIsLinear)
+			t = std::min(t, 1.0f + MAX_ROTATION / (2.0f * params.mAngle));
+
+		return params.evaluate(previous, t);
+	}
+}
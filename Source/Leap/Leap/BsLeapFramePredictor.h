@@ -0,0 +1,146 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapFrameUtility.h"
+#include "Leap/BsLeapFrameAlloc.h"
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	class LeapFrameHistory;
+
+	/**
+	 * Predicts hand poses at times past the newest tracking frame, to compensate for the latency of the pipeline.
+	 *
+	 * Every hand keeps its last three tracking samples. Joint positions are extrapolated with a constant acceleration
+	 * model fitted to them, orientations with the constant angular velocity between the last two. Each joint also keeps a
+	 * confidence measuring how well the model predicted its recent samples. The extrapolation of a joint is scaled down
+	 * by its confidence, so jittery or erratic joints are held close to their last tracked position instead of
+	 * overshooting.
+	 *
+	 * Predictions further than the maximum horizon past the newest frame are treated as a tracking loss, in which case
+	 * the newest frame is returned as is.
+	 */
+	class LeapFramePredictor
+	{
+	public:
+		/** Number of joints with a confidence in every hand, ordered as palm, the 4 bones of each digit, then arm. */
+		static constexpr UINT32 NUM_JOINTS = LeapFrameUtility::NUM_HAND_ROTATIONS;
+
+		/** Constructs a predictor extrapolating at most @p maxHorizon microseconds past the newest frame. */
+		LeapFramePredictor(INT64 maxHorizon = 100000);
+
+		/** Adds the frames pushed to @p history since the last update, up to the number of samples kept per hand. */
+		void update(const LeapFrameHistory& history);
+
+		/** Adds a tracking frame. Frames not newer than the newest frame added so far are ignored. */
+		void addFrame(const LeapFrame& frame);
+
+		/** Forgets every frame. */
+		void clear();
+
+		/**
+		 * Fills @p toFill with the hands of the newest frame predicted at @p timestamp, on the Leap clock. Times before the
+		 * newest frame return it unchanged, interpolation should be used for those.
+		 *
+		 * @returns	False if no frame was added yet.
+		 */
+		bool predict(INT64 timestamp, LeapFrameAlloc& toFill) const;
+
+		/**
+		 * Returns the confidence, in [0, 1], in a joint predicted at @p timestamp. Falls with the distance of @p timestamp
+		 * to the newest frame, and is 0 for joints that predict() held at their last tracked position.
+		 *
+		 * @param hand		Index of the hand in the newest frame, which is also its index in predicted frames.
+		 * @param joint		Index of the joint, in [0, NUM_JOINTS).
+		 * @param timestamp	Time of the prediction.
+		 */
+		float getJointConfidence(UINT32 hand, UINT32 joint, INT64 timestamp) const;
+
+		/** Returns the timestamp of the newest frame added, or 0 if there is none. */
+		INT64 getNewestTimestamp() const { return mHasFrame ? mNewestFrame.mInfo.timestamp : 0; }
+
+	private:
+		/** Number of tracking samples kept per hand, the minimum for estimating an acceleration. */
+		static constexpr UINT32 NUM_SAMPLES = 3;
+
+		/** Tracking samples of a single hand, and the confidence in each of its joints. */
+		struct HandState
+		{
+			UINT32 mId = 0;
+
+			/** Number of valid samples, stored at the end of the arrays. The newest sample is the last. */
+			UINT32 mNumSamples = 0;
+			INT64 mTimestamps[NUM_SAMPLES];
+			LeapHand mSamples[NUM_SAMPLES];
+
+			float mConfidence[NUM_JOINTS];
+		};
+
+		/**
+		 * Weights of the samples of a hand in its velocity and acceleration, oldest sample first. Positions are
+		 * extrapolated as a weighted sum of the samples.
+		 */
+		struct Derivatives
+		{
+			double mVelocity[NUM_SAMPLES];
+			double mAcceleration[NUM_SAMPLES];
+		};
+
+		/** Weights of the samples of a hand in an extrapolated position, oldest sample first. They sum to one. */
+		struct SampleWeights
+		{
+			float mWeights[NUM_SAMPLES];
+		};
+
+		/** Adds a sample to @p state, updating the confidence of its joints with the error of their prediction. */
+		void addSample(HandState& state, INT64 timestamp, const LeapHand& hand) const;
+
+		/** Extrapolates the newest sample of @p state by @p horizon microseconds into @p out. */
+		void predictHand(const HandState& state, INT64 horizon, LeapHand& out) const;
+
+		/**
+		 * Extrapolates a bone whose samples are @p oldest, @p previous and @p newest. Joints use @p weights, the rotation
+		 * is extrapolated by @p t times the time between the last two samples.
+		 */
+		static void predictBone(const LeapBone& oldest, const LeapBone& previous, const LeapBone& newest,
+			const SampleWeights& weights, float t, LeapBone& out);
+
+		/** Returns the confidence in the joints of a prediction @p horizon microseconds past the newest frame. */
+		float getHorizonFalloff(INT64 horizon) const;
+
+		/** Computes the derivatives weights of the samples of @p state. */
+		static Derivatives getDerivatives(const HandState& state);
+
+		/** Returns the weights of the samples of a joint extrapolated by @p horizon, damped by @p confidence. */
+		static SampleWeights getWeights(const Derivatives& derivatives, float confidence, INT64 horizon);
+
+		/** Returns the position of a joint of @p hand, the one its confidence is measured from. */
+		static Vector3 getJointPosition(const LeapHand& hand, UINT32 joint);
+
+		/** Extrapolates the position whose samples are @p oldest, @p previous and @p newest with the given weights. */
+		static Vector3 extrapolate(const SampleWeights& weights, const Vector3& oldest, const Vector3& previous,
+			const Vector3& newest);
+
+		/** Extrapolates the rotation from @p previous to @p newest by @p t times the time between them. */
+		static Quaternion extrapolate(const Quaternion& previous, const Quaternion& newest, float t);
+
+		INT64 mMaxHorizon;
+
+		/** Header of the newest frame, without hands. */
+		LeapFrame mNewestFrame;
+		bool mHasFrame = false;
+
+		/** States of the hands of the newest frame, in the same order. */
+		Vector<HandState> mHands;
+		Vector<HandState> mNextHands;
+
+		LeapFrameAlloc mReadFrame;
+	};
+
+	/** @} */
+}
@@ -5,40 +5,698 @@
 #include "Math/BsMatrix4.h"
 #include "Scene/BsTransform.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#	define BS_LEAP_SSE 1
+#	include <xmmintrin.h>
+#else
+#	define BS_LEAP_SSE 0
+#endif
+
 namespace bs
 {
+	namespace
+	{
+		/** Number of hands gathered into a single transform batch. */
+		constexpr UINT32 BATCH_HANDS = 4;
+
+		/** Number of points in a hand: two palm positions and two joints per bone, including the arm. */
+		constexpr UINT32 HAND_POSITIONS = 2 + 5 * 4 * 2 + 2;
+
+		/** Number of vectors in a hand: the palm velocity and direction. */
+		constexpr UINT32 HAND_VECTORS = 2;
+
+		/** Number of normals in a hand: the palm normal. */
+		constexpr UINT32 HAND_NORMALS = 1;
+
+		/** Number of orientations in a hand: the palm and every bone, including the arm. */
+		constexpr UINT32 HAND_ROTATIONS = LeapFrameUtility::NUM_HAND_ROTATIONS;
+
+		/** Rounds @p count up to a whole number of SIMD lanes. */
+		constexpr UINT32 padToLanes(UINT32 count) { return (count + 3) & ~3U; }
+
+		/** Transformation applied by the kernels. */
+		struct TransformParams
+		{
+			TransformParams(const Matrix4& matrix, const Quaternion& rotation)
+				: mRotation(rotation)
+			{
+				for (UINT32 row = 0; row < 3; ++row)
+				{
+					for (UINT32 column = 0; column < 4; ++column)
+						mMatrix[row][column] = matrix.m[row][column];
+				}
+
+				// The inverse transpose of the linear part is its cofactor matrix divided by its determinant. Normals are
+				// renormalized afterwards, so only the sign of the determinant matters.
+				const float (&m)[3][4] = mMatrix;
+				for (UINT32 row = 0; row < 3; ++row)
+				{
+					UINT32 r0 = (row + 1) % 3;
+					UINT32 r1 = (row + 2) % 3;
+
+					for (UINT32 column = 0; column < 3; ++column)
+					{
+						UINT32 c0 = (column + 1) % 3;
+						UINT32 c1 = (column + 2) % 3;
+
+						mNormalMatrix[row][column] = m[r0][c0] * m[r1][c1] - m[r0][c1] * m[r1][c0];
+					}
+
+					mNormalMatrix[row][3] = 0.0f;
+				}
+
+				float determinant = m[0][0] * mNormalMatrix[0][0] + m[0][1] * mNormalMatrix[0][1] +
+					m[0][2] * mNormalMatrix[0][2];
+
+				if (determinant < 0.0f)
+				{
+					for (auto& row : mNormalMatrix)
+					{
+						for (float& value : row)
+							value = -value;
+					}
+				}
+			}
+
+			/** Top three rows of the affine matrix. */
+			float mMatrix[3][4];
+
+			/**
+			 * Inverse transpose of the linear part of the matrix, up to a positive scale, with a zero translation.
+			 * Transforms normals so they stay perpendicular to the surfaces they belong to under non-uniform scale.
+			 */
+			float mNormalMatrix[3][4];
+
+			/** Rotation part of the matrix. */
+			Quaternion mRotation;
+		};
+
+		/** Transformable members of a batch of hands, gathered in structure of arrays form. */
+		struct TransformBatch
+		{
+			static constexpr UINT32 MAX_POSITIONS = padToLanes(BATCH_HANDS * HAND_POSITIONS);
+			static constexpr UINT32 MAX_VECTORS = padToLanes(BATCH_HANDS * HAND_VECTORS);
+			static constexpr UINT32 MAX_NORMALS = padToLanes(BATCH_HANDS * HAND_NORMALS);
+			static constexpr UINT32 MAX_ROTATIONS = padToLanes(BATCH_HANDS * HAND_ROTATIONS);
+
+			alignas(16) float mPosX[MAX_POSITIONS];
+			alignas(16) float mPosY[MAX_POSITIONS];
+			alignas(16) float mPosZ[MAX_POSITIONS];
+
+			alignas(16) float mVecX[MAX_VECTORS];
+			alignas(16) float mVecY[MAX_VECTORS];
+			alignas(16) float mVecZ[MAX_VECTORS];
+
+			alignas(16) float mNrmX[MAX_NORMALS];
+			alignas(16) float mNrmY[MAX_NORMALS];
+			alignas(16) float mNrmZ[MAX_NORMALS];
+
+			alignas(16) float mRotX[MAX_ROTATIONS];
+			alignas(16) float mRotY[MAX_ROTATIONS];
+			alignas(16) float mRotZ[MAX_ROTATIONS];
+			alignas(16) float mRotW[MAX_ROTATIONS];
+
+			UINT32 mNumPositions = 0;
+			UINT32 mNumVectors = 0;
+			UINT32 mNumNormals = 0;
+			UINT32 mNumRotations = 0;
+		};
+
+		/**
+		 * Passes every transformable member of @p hand through the matching callback and stores the result back. Points
+		 * go through @p position, velocities through @p vector, unit vectors along the hand through @p direction, the
+		 * palm normal through @p normal and orientations through @p rotation. Gathering and scattering both go through
+		 * here, so they always agree on the order.
+		 */
+		template<class P, class V, class D, class N, class R>
+		void visitHand(LeapHand& hand, P position, V vector, D direction, N normal, R rotation)
+		{
+			LeapPalm& palm = hand.mPalm;
+			palm.mPosition = position(palm.mPosition);
+			palm.mStabilizedPosition = position(palm.mStabilizedPosition);
+			palm.mVelocity = vector(palm.mVelocity);
+			palm.mNormal = normal(palm.mNormal);
+			palm.mDirection = direction(palm.mDirection);
+			palm.mOrientation = rotation(palm.mOrientation);
+
+			auto visitBone = [&](LeapBone& bone)
+			{
+				bone.mPrevJoint = position(bone.mPrevJoint);
+				bone.mNextJoint = position(bone.mNextJoint);
+				bone.mRotation = rotation(bone.mRotation);
+			};
+
+			for (UINT32 i = 0; i < 5; ++i)
+			{
+				for (UINT32 j = 0; j < 4; ++j)
+					visitBone(hand.mDigits[i].mBones[j]);
+			}
+
+			visitBone(hand.mArm);
+		}
+
+		/** Zeroes the lanes past @p count, so the kernels never read uninitialized values. */
+		void clearPadding(float* values, UINT32 count)
+		{
+			for (UINT32 i = count; i < padToLanes(count); ++i)
+				values[i] = 0.0f;
+		}
+
+		/** Properties of a LeapTransformKind that decide which members of a hand change. */
+		template<LeapTransformKind K>
+		struct TransformTraits
+		{
+			/** True if points move. */
+			static constexpr bool MOVES_POINTS = K != LeapTransformKind::Identity;
+
+			/** True if velocities change. */
+			static constexpr bool CHANGES_VECTORS = K == LeapTransformKind::TranslateUniformScale ||
+				K == LeapTransformKind::Affine;
+
+			/** True if unit vectors and orientations change. */
+			static constexpr bool ROTATES = K == LeapTransformKind::Affine;
+		};
+
+		/** Copies the members of @p hands changed by transformations of kind @p K into @p batch. */
+		template<LeapTransformKind K>
+		void gather(LeapHand* hands, UINT32 numHands, TransformBatch& batch)
+		{
+			typedef TransformTraits<K> Traits;
+
+			UINT32 numPositions = 0;
+			UINT32 numVectors = 0;
+			UINT32 numNormals = 0;
+			UINT32 numRotations = 0;
+
+			auto gatherPosition = [&](const Vector3& value)
+			{
+				batch.mPosX[numPositions] = value.x;
+				batch.mPosY[numPositions] = value.y;
+				batch.mPosZ[numPositions] = value.z;
+				numPositions++;
+
+				return value;
+			};
+
+			auto gatherVector = [&](const Vector3& value)
+			{
+				if (Traits::CHANGES_VECTORS)
+				{
+					batch.mVecX[numVectors] = value.x;
+					batch.mVecY[numVectors] = value.y;
+					batch.mVecZ[numVectors] = value.z;
+					numVectors++;
+				}
+
+				return value;
+			};
+
+			auto gatherDirection = [&](const Vector3& value)
+			{
+				return Traits::ROTATES ? gatherVector(value) : value;
+			};
+
+			auto gatherNormal = [&](const Vector3& value)
+			{
+				if (Traits::ROTATES)
+				{
+					batch.mNrmX[numNormals] = value.x;
+					batch.mNrmY[numNormals] = value.y;
+					batch.mNrmZ[numNormals] = value.z;
+					numNormals++;
+				}
+
+				return value;
+			};
+
+			auto gatherRotation = [&](const Quaternion& value)
+			{
+				if (Traits::ROTATES)
+				{
+					batch.mRotX[numRotations] = value.x;
+					batch.mRotY[numRotations] = value.y;
+					batch.mRotZ[numRotations] = value.z;
+					batch.mRotW[numRotations] = value.w;
+					numRotations++;
+				}
+
+				return value;
+			};
+
+			for (UINT32 i = 0; i < numHands; ++i)
+				visitHand(hands[i], gatherPosition, gatherVector, gatherDirection, gatherNormal, gatherRotation);
+
+			batch.mNumPositions = numPositions;
+			batch.mNumVectors = numVectors;
+			batch.mNumNormals = numNormals;
+			batch.mNumRotations = numRotations;
+
+			for (float* values : { batch.mPosX, batch.mPosY, batch.mPosZ })
+				clearPadding(values, numPositions);
+
+			for (float* values : { batch.mVecX, batch.mVecY, batch.mVecZ })
+				clearPadding(values, numVectors);
+
+			for (float* values : { batch.mNrmX, batch.mNrmY, batch.mNrmZ })
+				clearPadding(values, numNormals);
+
+			for (float* values : { batch.mRotX, batch.mRotY, batch.mRotZ, batch.mRotW })
+				clearPadding(values, numRotations);
+		}
+
+		/**
+		 * Copies the transformed members in @p batch back into @p hands. Must use the same @p K as the matching gather().
+		 * Unit vectors are renormalized.
+		 */
+		template<LeapTransformKind K>
+		void scatter(const TransformBatch& batch, LeapHand* hands, UINT32 numHands)
+		{
+			typedef TransformTraits<K> Traits;
+
+			UINT32 numPositions = 0;
+			UINT32 numVectors = 0;
+			UINT32 numNormals = 0;
+			UINT32 numRotations = 0;
+
+			auto scatterPosition = [&](const Vector3&)
+			{
+				Vector3 value(batch.mPosX[numPositions], batch.mPosY[numPositions], batch.mPosZ[numPositions]);
+				numPositions++;
+
+				return value;
+			};
+
+			auto scatterVector = [&](const Vector3& value)
+			{
+				if (!Traits::CHANGES_VECTORS)
+					return value;
+
+				Vector3 transformed(batch.mVecX[numVectors], batch.mVecY[numVectors], batch.mVecZ[numVectors]);
+				numVectors++;
+
+				return transformed;
+			};
+
+			auto scatterDirection = [&](const Vector3& value)
+			{
+				return Traits::ROTATES ? Vector3::normalize(scatterVector(value)) : value;
+			};
+
+			auto scatterNormal = [&](const Vector3& value)
+			{
+				if (!Traits::ROTATES)
+					return value;
+
+				Vector3 transformed(batch.mNrmX[numNormals], batch.mNrmY[numNormals], batch.mNrmZ[numNormals]);
+				numNormals++;
+
+				return Vector3::normalize(transformed);
+			};
+
+			auto scatterRotation = [&](const Quaternion& value)
+			{
+				if (!Traits::ROTATES)
+					return value;
+
+				Quaternion transformed;
+				transformed.x = batch.mRotX[numRotations];
+				transformed.y = batch.mRotY[numRotations];
+				transformed.z = batch.mRotZ[numRotations];
+				transformed.w = batch.mRotW[numRotations];
+				numRotations++;
+
+				return transformed;
+			};
+
+			for (UINT32 i = 0; i < numHands; ++i)
+				visitHand(hands[i], scatterPosition, scatterVector, scatterDirection, scatterNormal, scatterRotation);
+		}
+
+		/**
+		 * Applies a transformation of kind @p K with the top three rows @p m of its matrix to @p count vectors, in place.
+		 * Only points are translated, vectors go through the linear part alone. @p count must be a multiple of the SIMD
+		 * lane count.
+		 */
+		template<LeapTransformKind K, bool TRANSLATE>
+		void transformVectors(float* x, float* y, float* z, UINT32 count, const float (&m)[3][4])
+		{
+#if BS_LEAP_SSE
+			const __m128 m00 = _mm_set1_ps(m[0][0]), m01 = _mm_set1_ps(m[0][1]), m02 = _mm_set1_ps(m[0][2]);
+			const __m128 m10 = _mm_set1_ps(m[1][0]), m11 = _mm_set1_ps(m[1][1]), m12 = _mm_set1_ps(m[1][2]);
+			const __m128 m20 = _mm_set1_ps(m[2][0]), m21 = _mm_set1_ps(m[2][1]), m22 = _mm_set1_ps(m[2][2]);
+			const __m128 tx = _mm_set1_ps(m[0][3]);
+			const __m128 ty = _mm_set1_ps(m[1][3]);
+			const __m128 tz = _mm_set1_ps(m[2][3]);
+
+			for (UINT32 i = 0; i < count; i += 4)
+			{
+				__m128 rx = _mm_load_ps(x + i);
+				__m128 ry = _mm_load_ps(y + i);
+				__m128 rz = _mm_load_ps(z + i);
+
+				if (K == LeapTransformKind::Affine)
+				{
+					__m128 vx = rx, vy = ry, vz = rz;
+					rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, vx), _mm_mul_ps(m01, vy)), _mm_mul_ps(m02, vz));
+					ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, vx), _mm_mul_ps(m11, vy)), _mm_mul_ps(m12, vz));
+					rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, vx), _mm_mul_ps(m21, vy)), _mm_mul_ps(m22, vz));
+				}
+				else if (K == LeapTransformKind::TranslateUniformScale)
+				{
+					// No rotation and a uniform scale, so the diagonal holds the scale
+					rx = _mm_mul_ps(m00, rx);
+					ry = _mm_mul_ps(m00, ry);
+					rz = _mm_mul_ps(m00, rz);
+				}
+
+				if (TRANSLATE)
+				{
+					rx = _mm_add_ps(rx, tx);
+					ry = _mm_add_ps(ry, ty);
+					rz = _mm_add_ps(rz, tz);
+				}
+
+				_mm_store_ps(x + i, rx);
+				_mm_store_ps(y + i, ry);
+				_mm_store_ps(z + i, rz);
+			}
+#else
+			for (UINT32 i = 0; i < count; ++i)
+			{
+				float vx = x[i];
+				float vy = y[i];
+				float vz = z[i];
+
+				if (K == LeapTransformKind::Affine)
+				{
+					x[i] = m[0][0] * vx + m[0][1] * vy + m[0][2] * vz;
+					y[i] = m[1][0] * vx + m[1][1] * vy + m[1][2] * vz;
+					z[i] = m[2][0] * vx + m[2][1] * vy + m[2][2] * vz;
+				}
+				else if (K == LeapTransformKind::TranslateUniformScale)
+				{
+					x[i] = m[0][0] * vx;
+					y[i] = m[0][0] * vy;
+					z[i] = m[0][0] * vz;
+				}
+
+				if (TRANSLATE)
+				{
+					x[i] += m[0][3];
+					y[i] += m[1][3];
+					z[i] += m[2][3];
+				}
+			}
+#endif
+		}
+
+		/**
+		 * Premultiplies @p count quaternions by the rotation in @p t, in place. @p count must be a multiple of the SIMD
+		 * lane count.
+		 */
+		void rotateQuaternions(float* x, float* y, float* z, float* w, UINT32 count, const TransformParams& t)
+		{
+			const Quaternion& r = t.mRotation;
+
+#if BS_LEAP_SSE
+			const __m128 rx = _mm_set1_ps(r.x);
+			const __m128 ry = _mm_set1_ps(r.y);
+			const __m128 rz = _mm_set1_ps(r.z);
+			const __m128 rw = _mm_set1_ps(r.w);
+
+			for (UINT32 i = 0; i < count; i += 4)
+			{
+				__m128 qx = _mm_load_ps(x + i);
+				__m128 qy = _mm_load_ps(y + i);
+				__m128 qz = _mm_load_ps(z + i);
+				__m128 qw = _mm_load_ps(w + i);
+
+				__m128 ow = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(rw, qw), _mm_mul_ps(rx, qx)), _mm_add_ps(_mm_mul_ps(ry, qy), _mm_mul_ps(rz, qz)));
+				__m128 ox = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rw, qx), _mm_mul_ps(rx, qw)), _mm_sub_ps(_mm_mul_ps(ry, qz), _mm_mul_ps(rz, qy)));
+				__m128 oy = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, qy), _mm_mul_ps(rx, qz)), _mm_add_ps(_mm_mul_ps(ry, qw), _mm_mul_ps(rz, qx)));
+				__m128 oz = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, qz), _mm_mul_ps(ry, qx)), _mm_add_ps(_mm_mul_ps(rx, qy), _mm_mul_ps(rz, qw)));
+
+				_mm_store_ps(x + i, ox);
+				_mm_store_ps(y + i, oy);
+				_mm_store_ps(z + i, oz);
+				_mm_store_ps(w + i, ow);
+			}
+#else
+			for (UINT32 i = 0; i < count; ++i)
+			{
+				float qx = x[i];
+				float qy = y[i];
+				float qz = z[i];
+				float qw = w[i];
+
+				w[i] = r.w * qw - r.x * qx - r.y * qy - r.z * qz;
+				x[i] = r.w * qx + r.x * qw + r.y * qz - r.z * qy;
+				y[i] = r.w * qy - r.x * qz + r.y * qw + r.z * qx;
+				z[i] = r.w * qz + r.x * qy - r.y * qx + r.z * qw;
+			}
+#endif
+		}
+
+		/** Applies a transformation of kind @p K to @p numHands hands, a batch of hands at a time. */
+		template<LeapTransformKind K>
+		void transformHands(LeapHand* hands, UINT32 numHands, const TransformParams& t)
+		{
+			typedef TransformTraits<K> Traits;
+
+			if (!Traits::MOVES_POINTS)
+				return;
+
+			TransformBatch batch;
+			for (UINT32 first = 0; first < numHands; first += BATCH_HANDS)
+			{
+				UINT32 count = std::min(BATCH_HANDS, numHands - first);
+				gather<K>(hands + first, count, batch);
+
+				transformVectors<K, true>(batch.mPosX, batch.mPosY, batch.mPosZ, padToLanes(batch.mNumPositions),
+					t.mMatrix);
+
+				if (Traits::CHANGES_VECTORS)
+				{
+					transformVectors<K, false>(batch.mVecX, batch.mVecY, batch.mVecZ, padToLanes(batch.mNumVectors),
+						t.mMatrix);
+				}
+
+				if (Traits::ROTATES)
+				{
+					transformVectors<K, false>(batch.mNrmX, batch.mNrmY, batch.mNrmZ, padToLanes(batch.mNumNormals),
+						t.mNormalMatrix);
+
+					rotateQuaternions(batch.mRotX, batch.mRotY, batch.mRotZ, batch.mRotW, padToLanes(batch.mNumRotations),
+						t);
+				}
+
+				scatter<K>(batch, hands + first, count);
+			}
+		}
+
+		/** Applies a transformation of the given kind to @p numHands hands. */
+		void transformHands(LeapTransformKind kind, LeapHand* hands, UINT32 numHands, const TransformParams& t)
+		{
+			switch (kind)
+			{
+			case LeapTransformKind::Identity:
+				break;
+			case LeapTransformKind::Translate:
+				transformHands<LeapTransformKind::Translate>(hands, numHands, t);
+				break;
+			case LeapTransformKind::TranslateUniformScale:
+				transformHands<LeapTransformKind::TranslateUniformScale>(hands, numHands, t);
+				break;
+			case LeapTransformKind::Affine:
+				transformHands<LeapTransformKind::Affine>(hands, numHands, t);
+				break;
+			}
+		}
+	}
+
+	LeapSlerpParams::LeapSlerpParams(const Quaternion& from, const Quaternion& to)
+		: mTo(to)
+	{
+		float cos = from.dot(to);
+		if (cos < 0.0f)
+		{
+			cos = -cos;
+			mTo = -to;
+		}
+
+		// Same threshold as Quaternion::slerp()
+		if (cos < 1.0f - 1e-3f)
+		{
+			float sin = std::sqrt(1.0f - cos * cos);
+			mAngle = std::atan2(sin, cos);
+			mInvSinAngle = 1.0f / sin;
+			mIsLinear = false;
+		}
+	}
+
+	Quaternion LeapSlerpParams::evaluate(const Quaternion& from, float t) const
+	{
+		if (mIsLinear)
+		{
+			Quaternion result = from * (1.0f - t) + mTo * t;
+			result.normalize();
+
+			return result;
+		}
+
+		float fromWeight = std::sin((1.0f - t) * mAngle) * mInvSinAngle;
+		float toWeight = std::sin(t * mAngle) * mInvSinAngle;
+		return from * fromWeight + mTo * toWeight;
+	}
+
+	LeapTransformKind LeapFrameUtility::getTransformKind(const Transform& t)
+	{
+		return getTransformKind(t.getPosition(), t.getRotation(), t.getScale());
+	}
+
+	LeapTransformKind LeapFrameUtility::getTransformKind(const Vector3& position, const Quaternion& rotation,
+		const Vector3& scale)
+	{
+		// Negative scales mirror unit vectors, which only the affine path handles
+		bool isUniformScale = scale.x == scale.y && scale.x == scale.z && scale.x > 0.0f;
+		if (rotation != Quaternion::IDENTITY || !isUniformScale)
+			return LeapTransformKind::Affine;
+
+		if (scale.x != 1.0f)
+			return LeapTransformKind::TranslateUniformScale;
+
+		if (position != Vector3::ZERO)
+			return LeapTransformKind::Translate;
+
+		return LeapTransformKind::Identity;
+	}
+
 	void LeapFrameUtility::transform(LeapFrame* frame, const Transform& t)
 	{
-		Matrix4 m = t.getMatrix();
-		transform(frame, m);
+		LeapTransformKind kind = getTransformKind(t);
+		if (kind == LeapTransformKind::Identity)
+			return;
+
+		transformHands(kind, frame->mHands, frame->mNumberOfHands, TransformParams(t.getMatrix(), t.getRotation()));
 	}
 
 	void LeapFrameUtility::transform(LeapFrame* frame, const Matrix4& m)
 	{
-		for (UINT32 i = 0; i < frame->mNumberOfHands; ++i)
-			transform(frame->mHands + i, m);
+		Vector3 position;
+		Quaternion rotation;
+		Vector3 scale;
+		m.decomposition(position, rotation, scale);
+
+		LeapTransformKind kind = getTransformKind(position, rotation, scale);
+		transformHands(kind, frame->mHands, frame->mNumberOfHands, TransformParams(m, rotation));
 	}
 
-	void LeapFrameUtility::transform(LeapBone& bone, const Matrix4& m)
+	void LeapFrameUtility::interpolate(const LeapFrame* from, const LeapFrame* to, float t, LeapFrame* out)
 	{
-		bone.mNextJoint = m.multiplyAffine(bone.mNextJoint);
-		bone.mPrevJoint = m.multiplyAffine(bone.mPrevJoint);
+		const LeapFrame* nearest = t < 0.5f ? from : to;
+		const LeapFrame* other = t < 0.5f ? to : from;
+
+		// Frames outside of the output buffer are only read from, so the hand pointer must be preserved
+		LeapHand* hands = out->mHands;
+		*out = *nearest;
+		out->mHands = hands;
+
+		out->mInfo.timestamp = from->mInfo.timestamp + (INT64)((to->mInfo.timestamp - from->mInfo.timestamp) * (double)t);
+		out->mFramerate = from->mFramerate + (to->mFramerate - from->mFramerate) * t;
+
+		for (UINT32 i = 0; i < nearest->mNumberOfHands; ++i)
+		{
+			const LeapHand& hand = nearest->mHands[i];
+
+			const LeapHand* match = NULL;
+			for (UINT32 j = 0; j < other->mNumberOfHands; ++j)
+			{
+				if (other->mHands[j].mId == hand.mId)
+				{
+					match = &other->mHands[j];
+					break;
+				}
+			}
+
+			if (match == NULL)
+				out->mHands[i] = hand;
+			else if (nearest == from)
+				interpolate(hand, *match, t, out->mHands[i]);
+			else
+				interpolate(*match, hand, t, out->mHands[i]);
+		}
+	}
+
+	void LeapFrameUtility::prepareInterpolation(const LeapHand& from, const LeapHand& to, LeapSlerpParams* params)
+	{
+		// Same order as visitHand(), palm first and arm last
+		*params++ = LeapSlerpParams(from.mPalm.mOrientation, to.mPalm.mOrientation);
+
+		for (UINT32 i = 0; i < 5; ++i)
+		{
+			for (UINT32 j = 0; j < 4; ++j)
+				*params++ = LeapSlerpParams(from.mDigits[i].mBones[j].mRotation, to.mDigits[i].mBones[j].mRotation);
+		}
+
+		*params = LeapSlerpParams(from.mArm.mRotation, to.mArm.mRotation);
 	}
 
-	void LeapFrameUtility::transform(LeapFinger& finger, const Matrix4& m)
+	void LeapFrameUtility::interpolate(const LeapBone& from, const LeapBone& to, const LeapSlerpParams& rotation,
+		float t, LeapBone& out)
 	{
-		for (UINT32 i = 0; i < 4; ++i)
-			transform(finger.mBones[i], m);
+		out.mPrevJoint = Vector3::lerp(t, from.mPrevJoint, to.mPrevJoint);
+		out.mNextJoint = Vector3::lerp(t, from.mNextJoint, to.mNextJoint);
+		out.mWidth = from.mWidth + (to.mWidth - from.mWidth) * t;
+		out.mRotation = rotation.evaluate(from.mRotation, t);
 	}
 
-	void LeapFrameUtility::transform(LeapHand* hand, const Matrix4& m)
+	void LeapFrameUtility::interpolate(const LeapHand& from, const LeapHand& to, float t, LeapHand& out)
 	{
-		hand->mPalm.mPosition = m.multiplyAffine(hand->mPalm.mPosition);
-		hand->mPalm.mStabilizedPosition = m.multiplyAffine(hand->mPalm.mStabilizedPosition);
+		LeapSlerpParams params[NUM_HAND_ROTATIONS];
+		prepareInterpolation(from, to, params);
+
+		interpolate(from, to, params, t, out);
+	}
+
+	void LeapFrameUtility::interpolate(const LeapHand& from, const LeapHand& to, const LeapSlerpParams* params, float t,
+		LeapHand& out)
+	{
+		const LeapHand& nearest = t < 0.5f ? from : to;
+		out.mId = nearest.mId;
+		out.mFlags = nearest.mFlags;
+		out.mType = nearest.mType;
+		out.mVisibleTime = nearest.mVisibleTime;
+
+		out.mConfidence = from.mConfidence + (to.mConfidence - from.mConfidence) * t;
+		out.mPinchDistance = from.mPinchDistance + (to.mPinchDistance - from.mPinchDistance) * t;
+		out.mGrabAngle = from.mGrabAngle + (to.mGrabAngle - from.mGrabAngle) * t;
+		out.mPinchStrength = from.mPinchStrength + (to.mPinchStrength - from.mPinchStrength) * t;
+		out.mGrabStrength = from.mGrabStrength + (to.mGrabStrength - from.mGrabStrength) * t;
+
+		const LeapPalm& fromPalm = from.mPalm;
+		const LeapPalm& toPalm = to.mPalm;
+		LeapPalm& palm = out.mPalm;
+		palm.mPosition = Vector3::lerp(t, fromPalm.mPosition, toPalm.mPosition);
+		palm.mStabilizedPosition = Vector3::lerp(t, fromPalm.mStabilizedPosition, toPalm.mStabilizedPosition);
+		palm.mVelocity = Vector3::lerp(t, fromPalm.mVelocity, toPalm.mVelocity);
+		palm.mNormal = Vector3::normalize(Vector3::lerp(t, fromPalm.mNormal, toPalm.mNormal));
+		palm.mWidth = fromPalm.mWidth + (toPalm.mWidth - fromPalm.mWidth) * t;
+		palm.mDirection = Vector3::normalize(Vector3::lerp(t, fromPalm.mDirection, toPalm.mDirection));
+		palm.mOrientation = params[0].evaluate(fromPalm.mOrientation, t);
 
 		for (UINT32 i = 0; i < 5; ++i)
-			transform(hand->mDigits[i], m);
+		{
+			const LeapFinger& fromFinger = from.mDigits[i];
+			const LeapFinger& toFinger = to.mDigits[i];
+			LeapFinger& finger = out.mDigits[i];
+
+			finger.mFingerId = (t < 0.5f ? fromFinger : toFinger).mFingerId;
+			finger.mIsExtended = (t < 0.5f ? fromFinger : toFinger).mIsExtended;
+
+			for (UINT32 j = 0; j < 4; ++j)
+				interpolate(fromFinger.mBones[j], toFinger.mBones[j], params[1 + i * 4 + j], t, finger.mBones[j]);
+		}
 
-		transform(hand->mArm, m);
+		interpolate(from.mArm, to.mArm, params[NUM_HAND_ROTATIONS - 1], t, out.mArm);
 	}
 }
\ No newline at end of file
@@ -10,25 +10,107 @@ namespace bs
 	*  @{
 	*/
 
+	/** Kinds of transformation, from the cheapest to the most expensive to apply to a frame. */
+	enum class LeapTransformKind
+	{
+		/** Leaves the frame unchanged. */
+		Identity,
+		/** Offsets the positions only. */
+		Translate,
+		/** Offsets and uniformly scales the positions, and scales the velocities. */
+		TranslateUniformScale,
+		/** Any other transformation, applied through the full matrix and rotation. */
+		Affine
+	};
+
+	/**
+	 * Spherical interpolation between two orientations, with everything that doesn't depend on the interpolation factor
+	 * computed up front. Gives the same results as Quaternion::slerp() taking the shortest path.
+	 */
+	struct LeapSlerpParams
+	{
+		LeapSlerpParams() = default;
+		LeapSlerpParams(const Quaternion& from, const Quaternion& to);
+
+		/** Returns the orientation at @p t in [0, 1], @p from being the orientation the parameters were computed from. */
+		Quaternion evaluate(const Quaternion& from, float t) const;
+
+		/** Target orientation, negated if needed so that the interpolation takes the shortest path. */
+		Quaternion mTo;
+
+		/** Angle between the two orientations, in radians. */
+		float mAngle = 0.0f;
+
+		/** Inverse of the sine of mAngle. */
+		float mInvSinAngle = 0.0f;
+
+		/** True if the orientations are too close for slerp to be stable, in which case they are lerped. */
+		bool mIsLinear = true;
+	};
+
 	/** Performs various operations on Leap frames. */
 	struct LeapFrameUtility
 	{
 	public:
-		/** Applies transformation to LeapFrame. */
+		/**
+		 * Applies transformation to LeapFrame. Joint and palm positions are transformed as points, the palm velocity and
+		 * direction as vectors, the palm normal through the inverse transpose so it stays perpendicular to the palm under
+		 * non-uniform scale, and the palm and bone orientations are rotated.
+		 */
 		static void transform(LeapFrame* frame, const Transform& t);
 
-		/** Applies transformation to LeapFrame. */
+		/** @copydoc transform(LeapFrame*, const Transform&) */
 		static void transform(LeapFrame* frame, const Matrix4& m);
 
-	private:
-		/** Applies transformation to LeapBone. */
-		static void transform(LeapBone& bone, const Matrix4& m);
+		/**
+		 * Returns the cheapest kind of transformation that applies @p t exactly. The transform() overloads use it to pick
+		 * a specialized path, so a provider at the origin or only offset from it costs little or nothing.
+		 */
+		static LeapTransformKind getTransformKind(const Transform& t);
+
+		/** @copydoc getTransformKind(const Transform&) */
+		static LeapTransformKind getTransformKind(const Vector3& position, const Quaternion& rotation,
+			const Vector3& scale);
+
+		/**
+		 * Interpolates between two frames. Positions and scalars are interpolated linearly, orientations spherically.
+		 * Hands are matched by their id. The output contains the hands of the frame nearest to @p t, hands missing from
+		 * the other frame are copied as is.
+		 *
+		 * @param from	The earlier frame.
+		 * @param to	The later frame.
+		 * @param t		Interpolation factor in [0, 1], 0 returning @p from and 1 returning @p to.
+		 * @param out	Frame receiving the result. Must have room for the hands of the frame nearest to @p t. Its
+		 *				timestamp is interpolated, the rest of its header is copied from the nearest frame.
+		 */
+		static void interpolate(const LeapFrame* from, const LeapFrame* to, float t, LeapFrame* out);
 
-		/** Applies transformation to LeapFinger. */
-		static void transform(LeapFinger& finger, const Matrix4& m);
+		/** Number of orientations in a hand, which is the number of LeapSlerpParams needed to interpolate it. */
+		static constexpr UINT32 NUM_HAND_ROTATIONS = 1 + 5 * 4 + 1;
+
+		/**
+		 * Computes the parts of the interpolation between two hands that don't depend on the interpolation factor.
+		 *
+		 * @param from		The earlier hand.
+		 * @param to		The later hand.
+		 * @param params	Receives NUM_HAND_ROTATIONS entries.
+		 */
+		static void prepareInterpolation(const LeapHand& from, const LeapHand& to, LeapSlerpParams* params);
+
+		/**
+		 * Interpolates between two hands, using parameters computed by prepareInterpolation(). Interpolating the same
+		 * hands at several factors this way is much cheaper than calling interpolate() for each.
+		 */
+		static void interpolate(const LeapHand& from, const LeapHand& to, const LeapSlerpParams* params, float t,
+			LeapHand& out);
+
+	private:
+		/** Interpolates between two LeapBone. */
+		static void interpolate(const LeapBone& from, const LeapBone& to, const LeapSlerpParams& rotation, float t,
+			LeapBone& out);
 
-		/** Applies transformation to LeapHand. */
-		static void transform(LeapHand* hand, const Matrix4& m);
+		/** Interpolates between two LeapHand. */
+		static void interpolate(const LeapHand& from, const LeapHand& to, float t, LeapHand& out);
 	};
 
 	/** @} */
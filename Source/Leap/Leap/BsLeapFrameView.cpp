@@ -0,0 +1,165 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapFrameView.h"
+#include "Scene/BsTransform.h"
+
+namespace bs
+{
+	void LeapFrameView::reset(const LeapFrame* frame, const Transform& transform, UINT32 transformHash)
+	{
+		if (frame == nullptr)
+		{
+			clear();
+			return;
+		}
+
+		bool isSameFrame = mFrame != nullptr && mFrameId == frame->mInfo.frame_id &&
+			mTimestamp == frame->mInfo.timestamp && mTransformHash == transformHash;
+
+		mFrame = frame;
+		if (isSameFrame)
+			return;
+
+		mFrameId = frame->mInfo.frame_id;
+		mTimestamp = frame->mInfo.timestamp;
+		mTransformHash = transformHash;
+
+		mKind = LeapFrameUtility::getTransformKind(transform);
+		mMatrix = transform.getMatrix();
+		mRotation = transform.getRotation();
+
+		// Only the affine kind rotates normals, and only a non-uniform scale sets them apart from directions
+		if (mKind == LeapTransformKind::Affine)
+			mNormalMatrix = mMatrix.inverseAffine().transpose();
+
+		// Keeps the capacity, so views don't allocate once they saw the largest frame
+		mHands.resize(frame->mNumberOfHands);
+		mCachedBits.assign(frame->mNumberOfHands, 0);
+	}
+
+	void LeapFrameView::clear()
+	{
+		mFrame = nullptr;
+		mCachedBits.clear();
+	}
+
+	const LeapHand& LeapFrameView::getHand(UINT32 hand) const
+	{
+		if (mKind == LeapTransformKind::Identity)
+			return mFrame->mHands[hand];
+
+		LeapHand& cached = getCachedHand(hand);
+		UINT32& bits = mCachedBits[hand];
+		if (bits == ALL_BITS)
+			return cached;
+
+		getPalm(hand);
+		getArm(hand);
+
+		for (UINT32 i = 0; i < 5; ++i)
+			getDigit(hand, i);
+
+		return cached;
+	}
+
+	const LeapPalm& LeapFrameView::getPalm(UINT32 hand) const
+	{
+		if (mKind == LeapTransformKind::Identity)
+			return mFrame->mHands[hand].mPalm;
+
+		LeapHand& cached = getCachedHand(hand);
+		UINT32& bits = mCachedBits[hand];
+		if ((bits & PALM_BIT) == 0)
+		{
+			transformPalm(mFrame->mHands[hand].mPalm, cached.mPalm);
+			bits |= PALM_BIT;
+		}
+
+		return cached.mPalm;
+	}
+
+	const LeapFinger& LeapFrameView::getDigit(UINT32 hand, UINT32 digit) const
+	{
+		if (mKind == LeapTransformKind::Identity)
+			return mFrame->mHands[hand].mDigits[digit];
+
+		for (UINT32 i = 0; i < 4; ++i)
+			getBone(hand, digit, i);
+
+		return mHands[hand].mDigits[digit];
+	}
+
+	const LeapBone& LeapFrameView::getBone(UINT32 hand, UINT32 digit, UINT32 bone) const
+	{
+		if (mKind == LeapTransformKind::Identity)
+			return mFrame->mHands[hand].mDigits[digit].mBones[bone];
+
+		LeapHand& cached = getCachedHand(hand);
+		UINT32& bits = mCachedBits[hand];
+		UINT32 bit = getBoneBit(digit, bone);
+		if ((bits & bit) == 0)
+		{
+			transformBone(mFrame->mHands[hand].mDigits[digit].mBones[bone], cached.mDigits[digit].mBones[bone]);
+			bits |= bit;
+		}
+
+		return cached.mDigits[digit].mBones[bone];
+	}
+
+	const LeapBone& LeapFrameView::getArm(UINT32 hand) const
+	{
+		if (mKind == LeapTransformKind::Identity)
+			return mFrame->mHands[hand].mArm;
+
+		LeapHand& cached = getCachedHand(hand);
+		UINT32& bits = mCachedBits[hand];
+		if ((bits & ARM_BIT) == 0)
+		{
+			transformBone(mFrame->mHands[hand].mArm, cached.mArm);
+			bits |= ARM_BIT;
+		}
+
+		return cached.mArm;
+	}
+
+	LeapHand& LeapFrameView::getCachedHand(UINT32 hand) const
+	{
+		assert(hand < getNumHands());
+
+		// Copies the whole hand, the spatial members are overwritten as they are transformed
+		UINT32& bits = mCachedBits[hand];
+		if ((bits & HAND_BIT) == 0)
+		{
+			mHands[hand] = mFrame->mHands[hand];
+			bits |= HAND_BIT;
+		}
+
+		return mHands[hand];
+	}
+
+	void LeapFrameView::transformBone(const LeapBone& source, LeapBone& dest) const
+	{
+		dest.mPrevJoint = mMatrix.multiplyAffine(source.mPrevJoint);
+		dest.mNextJoint = mMatrix.multiplyAffine(source.mNextJoint);
+
+		if (mKind == LeapTransformKind::Affine)
+			dest.mRotation = mRotation * source.mRotation;
+	}
+
+	void LeapFrameView::transformPalm(const LeapPalm& source, LeapPalm& dest) const
+	{
+		dest.mPosition = mMatrix.multiplyAffine(source.mPosition);
+		dest.mStabilizedPosition = mMatrix.multiplyAffine(source.mStabilizedPosition);
+
+		if (mKind != LeapTransformKind::Translate)
+			dest.mVelocity = mMatrix.multiplyDirection(source.mVelocity);
+
+		if (mKind == LeapTransformKind::Affine)
+		{
+			dest.mNormal = Vector3::normalize(mNormalMatrix.multiplyDirection(source.mNormal));
+			dest.mDirection = Vector3::normalize(mMatrix.multiplyDirection(source.mDirection));
+			dest.mOrientation = mRotation * source.mOrientation;
+		}
+	}
+}
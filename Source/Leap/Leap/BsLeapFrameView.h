@@ -0,0 +1,98 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapFrameUtility.h"
+#include "Math/BsMatrix4.h"
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	/**
+	 * World space view over a frame in Leap space. Nothing is transformed up front: a palm, bone or arm is transformed
+	 * the first time it is accessed and cached until the view is reset to a different frame or transform. Readers
+	 * that only look at a few joints only pay for those joints.
+	 *
+	 * The view references the source frame without copying it, so it is only valid while the source frame is. Not
+	 * thread safe.
+	 */
+	class LeapFrameView
+	{
+	public:
+		/**
+		 * Points the view to a frame. Cached world space data is kept if @p frame has the same id and timestamp as the
+		 * previous frame and @p transformHash didn't change, otherwise it is discarded.
+		 *
+		 * @param frame			Frame in Leap space.
+		 * @param transform		Transform from Leap space to world space.
+		 * @param transformHash	Value that changes whenever @p transform changes, see SceneObject::getTransformHash().
+		 */
+		void reset(const LeapFrame* frame, const Transform& transform, UINT32 transformHash);
+
+		/** Detaches the view from its frame. */
+		void clear();
+
+		/** Returns true if the view points to a frame. */
+		bool isValid() const { return mFrame != nullptr; }
+
+		/** Returns the frame the view is over, in Leap space. */
+		const LeapFrame* getLeapFrame() const { return mFrame; }
+
+		/** Returns the number of hands in the frame. */
+		UINT32 getNumHands() const { return mFrame != nullptr ? mFrame->mNumberOfHands : 0; }
+
+		/** Returns a hand with all its members in world space. Transforms whatever wasn't accessed yet. */
+		const LeapHand& getHand(UINT32 hand) const;
+
+		/** Returns the palm of a hand in world space. */
+		const LeapPalm& getPalm(UINT32 hand) const;
+
+		/** Returns a digit of a hand, with all its bones in world space. */
+		const LeapFinger& getDigit(UINT32 hand, UINT32 digit) const;
+
+		/** Returns a bone of a digit in world space. */
+		const LeapBone& getBone(UINT32 hand, UINT32 digit, UINT32 bone) const;
+
+		/** Returns the arm of a hand in world space. */
+		const LeapBone& getArm(UINT32 hand) const;
+
+	private:
+		/** Bit set once the members not affected by the transform were copied. Bones use bits 0 to 19. */
+		static constexpr UINT32 HAND_BIT = 1U << 20;
+		static constexpr UINT32 PALM_BIT = 1U << 21;
+		static constexpr UINT32 ARM_BIT = 1U << 22;
+		static constexpr UINT32 ALL_BITS = (1U << 23) - 1;
+
+		/** Returns the bit of a bone. */
+		static constexpr UINT32 getBoneBit(UINT32 digit, UINT32 bone) { return 1U << (digit * 4 + bone); }
+
+		/** Returns the cached copy of a hand, copying it from the source frame on first access. */
+		LeapHand& getCachedHand(UINT32 hand) const;
+
+		/** Transforms a bone from Leap space to world space. */
+		void transformBone(const LeapBone& source, LeapBone& dest) const;
+
+		/** Transforms a palm from Leap space to world space. */
+		void transformPalm(const LeapPalm& source, LeapPalm& dest) const;
+
+		const LeapFrame* mFrame = nullptr;
+		INT64 mFrameId = 0;
+		INT64 mTimestamp = 0;
+		UINT32 mTransformHash = 0;
+
+		LeapTransformKind mKind = LeapTransformKind::Identity;
+		Matrix4 mMatrix;
+		Quaternion mRotation;
+
+		/** Inverse transpose of mMatrix, keeping palm normals perpendicular to the palm. Only set for affine kinds. */
+		Matrix4 mNormalMatrix;
+
+		mutable Vector<LeapHand> mHands;
+		mutable Vector<UINT32> mCachedBits;
+	};
+
+	/** @} */
+}
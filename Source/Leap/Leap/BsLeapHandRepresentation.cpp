@@ -6,14 +6,23 @@
 
 namespace bs
 {
-	LeapHandRepresentation::LeapHandRepresentation(CLeapHandModelManager* parent, const LeapHand* leapHand,
-		LeapModelKind kind)
+	LeapHandRepresentation::LeapHandRepresentation(CLeapHandModelManager* parent, const LeapFrameRef& frame,
+		UINT32 handIndex, LeapModelKind kind)
 	{
+		initialize(parent, frame, handIndex, kind);
+	}
+
+	void LeapHandRepresentation::initialize(CLeapHandModelManager* parent, const LeapFrameRef& frame,
+		UINT32 handIndex, LeapModelKind kind)
+	{
+		const LeapHand& leapHand = frame->mHands[handIndex];
+
 		mParent = parent;
-		mHandID = leapHand->mId;
-		mChirality = leapHand->mType;
+		mHandID = leapHand.mId;
+		mChirality = leapHand.mType;
 		mKind = kind;
-		mLeapHand = leapHand;
+		mFrame = frame;
+		mHandIndex = handIndex;
 	}
 
 	void LeapHandRepresentation::finish()
@@ -21,25 +30,36 @@ namespace bs
 		for (int i = 0; i < mHandModels.size(); i++)
 		{
 			mHandModels[i]->finishHand();
+
+			// Before returning it, the model may be handed to another representation right away
+			mHandModels[i]->_setJointWriter(NULL);
 			mParent->returnToPool(mHandModels[i]);
 			mHandModels[i] = NULL;
 		}
+
+		// Keeps the capacity, so the models of the next hand don't allocate
+		mHandModels.clear();
+		mFrame.release();
+
+		// Last, the manager may hand the representation to the next hand right away
 		mParent->removeHandRepresentation(this);
 	}
 
 	void LeapHandRepresentation::registerModel(HLeapHandModelBase model)
 	{
 		mHandModels.push_back(model);
+		model->_setJointWriter(mParent->_getJointWriter(mKind));
+
 		if (model->getLeapHand() == NULL)
 		{
-			model->setLeapHand(mLeapHand);
+			model->setLeapHand(getLeapHand());
 			model->onInitModel();
 			model->begin();
 			model->updateFrame();
 		}
 		else
 		{
-			model->setLeapHand(mLeapHand);
+			model->setLeapHand(getLeapHand());
 			model->begin();
 		}
 	}
@@ -47,13 +67,17 @@ namespace bs
 	void LeapHandRepresentation::removeModel(HLeapHandModelBase model)
 	{
 		model->finishHand();
+		model->_setJointWriter(NULL);
 		auto it = std::find(mHandModels.begin(), mHandModels.end(), model);
 		mHandModels.erase(it);
 	}
 
-	void LeapHandRepresentation::update(const LeapHand* leapHand)
+	void LeapHandRepresentation::update(const LeapFrameRef& frame, UINT32 handIndex)
 	{
-		mLeapHand = leapHand;
+		mFrame = frame;
+		mHandIndex = handIndex;
+
+		const LeapHand* leapHand = getLeapHand();
 		for (int i = 0; i < mHandModels.size(); i++)
 		{
 			mHandModels[i]->setLeapHand(leapHand);
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Leap/BsCLeapHandModel.h"
+#include "Leap/BsLeapFramePool.h"
 
 namespace bs
 {
@@ -18,7 +19,23 @@ namespace bs
 	class LeapHandRepresentation
 	{
 	public:
-		LeapHandRepresentation(CLeapHandModelManager* parent, const LeapHand* leapHand, const LeapModelKind kind);
+		/** Creates an unused representation, to be set up with initialize(). */
+		LeapHandRepresentation() = default;
+
+		/**
+		 * Creates a representation of a hand in a frame.
+		 *
+		 * @param parent	Manager owning the representation.
+		 * @param frame		Frame the hand belongs to.
+		 * @param handIndex	Index of the hand in @p frame.
+		 * @param kind		Kind of models driven by the representation.
+		 */
+		LeapHandRepresentation(CLeapHandModelManager* parent, const LeapFrameRef& frame, UINT32 handIndex,
+			const LeapModelKind kind);
+
+		/** Sets up the representation of a hand in a frame. Same parameters as the constructor. */
+		void initialize(CLeapHandModelManager* parent, const LeapFrameRef& frame, UINT32 handIndex,
+			const LeapModelKind kind);
 
 		int getHandId() const { return mHandID; }
 
@@ -26,34 +43,37 @@ namespace bs
 
 		LeapModelKind getKind() const { return mKind; }
 
-		const LeapHand* getLeapHand() const { return mLeapHand; }
+		/** Returns the hand, which stays valid until the next update() since the representation holds its frame. */
+		const LeapHand* getLeapHand() const { return &mFrame->mHands[mHandIndex]; }
 
-		/** To be called if the HandRepresentation no longer has a LeapHand. */
+		/**
+		 * To be called if the HandRepresentation no longer has a LeapHand. Releases the frame and the models, keeping the
+		 * storage for the models so the representation can be reused.
+		 */
 		void finish();
 
 		void registerModel(HLeapHandModelBase model);
 
 		void removeModel(HLeapHandModelBase model);
 
-		/** Calls updateHand to all registered LeapHandModels. */
-		void update(const LeapHand* leapHand);
+		/** Switches to the hand at @p handIndex in @p frame and calls updateHand to all registered LeapHandModels. */
+		void update(const LeapFrameRef& frame, UINT32 handIndex);
 
 	public:
 		Vector<HLeapHandModelBase> mHandModels;
 
-		bool mIsMarked;
-
 	protected:
-		eLeapHandType mChirality;
+		eLeapHandType mChirality = eLeapHandType_Left;
 
-		LeapModelKind mKind;
+		LeapModelKind mKind = LeapModelKind::Graphics;
 
-		const LeapHand* mLeapHand;
+		LeapFrameRef mFrame;
+		UINT32 mHandIndex = 0;
 
 	private:
-		CLeapHandModelManager* mParent;
+		CLeapHandModelManager* mParent = NULL;
 
-		int mHandID;
+		int mHandID = 0;
 	};
 
 	/** @} */
@@ -0,0 +1,75 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapHandRepresentationPool.h"
+
+namespace bs
+{
+	LeapHandRepresentationPool::LeapHandRepresentationPool(UINT32 capacity)
+		: mReps(capacity), mGenerations(capacity, 0), mIsInUse(capacity, false), mWasUsed(capacity, false)
+	{
+		// Handed out in index order, the most recently released one coming first afterwards
+		mFreeList.reserve(capacity);
+		for (UINT32 i = capacity; i > 0; i--)
+			mFreeList.push_back(i - 1);
+	}
+
+	LeapHandRepHandle LeapHandRepresentationPool::acquire()
+	{
+		if (mFreeList.empty())
+			return LeapHandRepHandle();
+
+		UINT32 index = mFreeList.back();
+		mFreeList.pop_back();
+
+		mIsInUse[index] = true;
+		if (mWasUsed[index])
+			mNumRecycled++;
+
+		mWasUsed[index] = true;
+		mPeakLive = std::max(mPeakLive, getNumLive());
+
+		LeapHandRepHandle handle;
+		handle.mIndex = index;
+		handle.mGeneration = mGenerations[index];
+		return handle;
+	}
+
+	LeapHandRepresentation* LeapHandRepresentationPool::get(LeapHandRepHandle handle)
+	{
+		if (handle.mIndex >= mReps.size() || !mIsInUse[handle.mIndex] || mGenerations[handle.mIndex] != handle.mGeneration)
+			return NULL;
+
+		return &mReps[handle.mIndex];
+	}
+
+	LeapHandRepHandle LeapHandRepresentationPool::getHandle(const LeapHandRepresentation* rep) const
+	{
+		UINT32 index = getIndex(rep);
+
+		LeapHandRepHandle handle;
+		handle.mIndex = index;
+		handle.mGeneration = mGenerations[index];
+		return handle;
+	}
+
+	void LeapHandRepresentationPool::release(LeapHandRepresentation* rep)
+	{
+		UINT32 index = getIndex(rep);
+		if (!mIsInUse[index])
+		{
+			LOGWRN("Releasing a hand representation that is not in use.");
+			return;
+		}
+
+		mIsInUse[index] = false;
+		mGenerations[index]++;
+		mFreeList.push_back(index);
+	}
+
+	UINT32 LeapHandRepresentationPool::getIndex(const LeapHandRepresentation* rep) const
+	{
+		assert(rep >= mReps.data() && rep < mReps.data() + mReps.size());
+		return (UINT32)(rep - mReps.data());
+	}
+}
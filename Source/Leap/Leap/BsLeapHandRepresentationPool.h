@@ -0,0 +1,94 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+#include "Leap/BsLeapHandRepresentation.h"
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	/**
+	 * Handle to a LeapHandRepresentation of a LeapHandRepresentationPool. Stops resolving once the representation is
+	 * released, even after its storage is reused by another representation.
+	 */
+	struct LeapHandRepHandle
+	{
+		UINT32 mIndex = (UINT32)-1;
+		UINT32 mGeneration = 0;
+
+		/** Returns true if the handle was obtained from a pool. It may still be stale. */
+		bool isSet() const { return mIndex != (UINT32)-1; }
+	};
+
+	/**
+	 * Fixed capacity pool of LeapHandRepresentation objects. All of them are created up front, so representations never
+	 * move and acquiring one never allocates. Released representations are recycled along with their storage for hand
+	 * models.
+	 */
+	class LeapHandRepresentationPool
+	{
+	public:
+		/** Creates a pool holding up to @p capacity representations at once. */
+		LeapHandRepresentationPool(UINT32 capacity = DEFAULT_CAPACITY);
+		LeapHandRepresentationPool(const LeapHandRepresentationPool&) = delete;
+
+		/**
+		 * Returns a handle to an unused representation, to be initialized by the caller. Returns an unset handle if all of
+		 * them are in use.
+		 */
+		LeapHandRepHandle acquire();
+
+		/** Returns the representation @p handle refers to, or null if it was released since. */
+		LeapHandRepresentation* get(LeapHandRepHandle handle);
+
+		/** Returns a handle to a representation of the pool that is in use. */
+		LeapHandRepHandle getHandle(const LeapHandRepresentation* rep) const;
+
+		/** Returns a representation to the pool. Handles to it stop resolving. */
+		void release(LeapHandRepresentation* rep);
+
+		/** Returns the maximum number of representations in use at once. */
+		UINT32 getCapacity() const { return (UINT32)mReps.size(); }
+
+		/** Returns the number of representations in use. */
+		UINT32 getNumLive() const { return getCapacity() - (UINT32)mFreeList.size(); }
+
+		/** Returns the highest number of representations that were in use at once. */
+		UINT32 getPeakLive() const { return mPeakLive; }
+
+		/** Returns how many times a previously released representation was acquired again. */
+		UINT64 getNumRecycled() const { return mNumRecycled; }
+
+	public:
+		/** Default capacity. Covers graphics and physics representations for several hands. */
+		static constexpr UINT32 DEFAULT_CAPACITY = 16;
+
+	private:
+		/** Returns the index of @p rep in mReps. */
+		UINT32 getIndex(const LeapHandRepresentation* rep) const;
+
+		/** Never resized after construction, so that representations don't move. */
+		Vector<LeapHandRepresentation> mReps;
+
+		/** Generation of every representation, incremented when it is released. */
+		Vector<UINT32> mGenerations;
+
+		/** True for representations that are in use. */
+		Vector<bool> mIsInUse;
+
+		/** True for representations that were used before. */
+		Vector<bool> mWasUsed;
+
+		/** Indices of the unused representations. The last one is acquired first. */
+		Vector<UINT32> mFreeList;
+
+		UINT32 mPeakLive = 0;
+		UINT64 mNumRecycled = 0;
+	};
+
+	/** @} */
+}
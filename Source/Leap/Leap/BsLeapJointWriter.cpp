@@ -0,0 +1,119 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapJointWriter.h"
+
+namespace bs
+{
+	void LeapJointWriter::setWorldPosition(const HSceneObject& sceneObject, const Vector3& position)
+	{
+		mWrites.push_back({ sceneObject, position });
+	}
+
+	void LeapJointWriter::commit()
+	{
+		UINT32 numWrites = (UINT32)mWrites.size();
+		if (numWrites == 0)
+			return;
+
+		// At most half full, so probe sequences stay short
+		UINT32 tableSize = 16;
+		while (tableSize < numWrites * 2)
+			tableSize *= 2;
+
+		mTable.assign(tableSize, INVALID_WRITE);
+		for (UINT32 i = 0; i < numWrites; i++)
+		{
+			if (!mWrites[i].mSceneObject.isDestroyed())
+				mTable[getTableSlot(mWrites[i].mSceneObject.get())] = i;
+		}
+
+		// Converted against the parents as they are before any write, joints of the same model mostly share their parent
+		mLocalPositions.resize(numWrites);
+
+		HSceneObject lastParent;
+		Quaternion invRotation = Quaternion::IDENTITY;
+		Vector3 invScale = Vector3::ONE;
+		Vector3 parentPosition = Vector3::ZERO;
+		for (UINT32 i = 0; i < numWrites; i++)
+		{
+			const Write& write = mWrites[i];
+			if (write.mSceneObject.isDestroyed())
+				continue;
+
+			HSceneObject parent = write.mSceneObject->getParent();
+			if (parent == NULL)
+			{
+				mLocalPositions[i] = write.mPosition;
+				continue;
+			}
+
+			if (parent != lastParent)
+			{
+				const Transform& parentTfrm = parent->getTransform();
+
+				invRotation = parentTfrm.getRotation().inverse();
+				invScale = parentTfrm.getScale();
+				invScale.x = invScale.x != 0.0f ? 1.0f / invScale.x : 0.0f;
+				invScale.y = invScale.y != 0.0f ? 1.0f / invScale.y : 0.0f;
+				invScale.z = invScale.z != 0.0f ? 1.0f / invScale.z : 0.0f;
+
+				parentPosition = getCommittedPosition(parent);
+
+				lastParent = parent;
+			}
+
+			mLocalPositions[i] = invRotation.rotate(write.mPosition - parentPosition) * invScale;
+		}
+
+		for (UINT32 i = 0; i < numWrites; i++)
+		{
+			if (!mWrites[i].mSceneObject.isDestroyed())
+				mWrites[i].mSceneObject->setPosition(mLocalPositions[i]);
+		}
+
+		mWrites.clear();
+	}
+
+	UINT32 LeapJointWriter::findWrite(const SceneObject* sceneObject) const
+	{
+		UINT32 slot = getTableSlot(sceneObject);
+		UINT32 index = mTable[slot];
+		if (index == INVALID_WRITE || mWrites[index].mSceneObject.get() != sceneObject)
+			return INVALID_WRITE;
+
+		return index;
+	}
+
+	Vector3 LeapJointWriter::getCommittedPosition(const HSceneObject& sceneObject) const
+	{
+		// Rotations and scales don't change, so moving the nearest written ancestor translates everything below it that
+		// isn't written itself by the same amount
+		HSceneObject ancestor = sceneObject;
+		while (ancestor != NULL)
+		{
+			UINT32 write = findWrite(ancestor.get());
+			if (write != INVALID_WRITE)
+			{
+				Vector3 offset = mWrites[write].mPosition - ancestor->getTransform().getPosition();
+				return sceneObject->getTransform().getPosition() + offset;
+			}
+
+			ancestor = ancestor->getParent();
+		}
+
+		return sceneObject->getTransform().getPosition();
+	}
+
+	UINT32 LeapJointWriter::getTableSlot(const SceneObject* sceneObject) const
+	{
+		// Fibonacci hashing of the address, probing linearly until the object or an empty slot is found
+		UINT32 mask = (UINT32)mTable.size() - 1;
+		UINT32 slot = (UINT32)(((UINT64)(uintptr_t)sceneObject * 0x9E3779B97F4A7C15ULL) >> 40) & mask;
+
+		while (mTable[slot] != INVALID_WRITE && mWrites[mTable[slot]].mSceneObject.get() != sceneObject)
+			slot = (slot + 1) & mask;
+
+		return slot;
+	}
+}
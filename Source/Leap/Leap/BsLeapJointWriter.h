@@ -0,0 +1,66 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+#include "Scene/BsSceneObject.h"
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	/**
+	 * Batches the world positions hand models set on their joints. Setting a world position on a scene object resolves
+	 * the world transform of its parent, which the previous write dirtied whenever joints are nested. The writer instead
+	 * queues the positions, converts all of them to local space in a single pass over the parents as they are before the
+	 * writes, and only then applies them.
+	 *
+	 * Only positions are written, so the rotation and scale of every parent stays the same. A parent that is queued ends
+	 * up at its queued position, one that isn't moves along with its nearest queued ancestor. Joints and any of their
+	 * ancestors can therefore be queued in any order, with or without the objects in between. Storage is reused between
+	 * commits, so the writer stops allocating once it has seen the largest batch.
+	 */
+	class LeapJointWriter
+	{
+	public:
+		LeapJointWriter() = default;
+		LeapJointWriter(const LeapJointWriter&) = delete;
+
+		/** Queues setting the world position of @p sceneObject. The last position queued for a scene object wins. */
+		void setWorldPosition(const HSceneObject& sceneObject, const Vector3& position);
+
+		/** Applies every queued position, skipping scene objects destroyed in the meantime, and empties the queue. */
+		void commit();
+
+		/** Returns the number of queued positions. */
+		UINT32 getNumPending() const { return (UINT32)mWrites.size(); }
+
+	private:
+		struct Write
+		{
+			HSceneObject mSceneObject;
+			Vector3 mPosition;
+		};
+
+		/** Returns the index of the last write queued for @p sceneObject, or INVALID_WRITE if there is none. */
+		UINT32 findWrite(const SceneObject* sceneObject) const;
+
+		/** Returns the world position @p sceneObject has once every queued write is applied. */
+		Vector3 getCommittedPosition(const HSceneObject& sceneObject) const;
+
+		/** Returns the slot of @p sceneObject in mTable. */
+		UINT32 getTableSlot(const SceneObject* sceneObject) const;
+
+		static constexpr UINT32 INVALID_WRITE = (UINT32)-1;
+
+		Vector<Write> mWrites;
+		Vector<Vector3> mLocalPositions;
+
+		/** Open addressing table from scene objects to the index of their last write. Its size is a power of two. */
+		Vector<UINT32> mTable;
+	};
+
+	/** @} */
+}
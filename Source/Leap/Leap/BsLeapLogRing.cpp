@@ -0,0 +1,181 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapLogRing.h"
+
+namespace bs
+{
+	String toString(eLeapRS r)
+	{
+		switch (r)
+		{
+		case eLeapRS_Success:
+			return "eLeapRS_Success";
+		case eLeapRS_UnknownError:
+			return "eLeapRS_UnknownError";
+		case eLeapRS_InvalidArgument:
+			return "eLeapRS_InvalidArgument";
+		case eLeapRS_InsufficientResources:
+			return "eLeapRS_InsufficientResources";
+		case eLeapRS_InsufficientBuffer:
+			return "eLeapRS_InsufficientBuffer";
+		case eLeapRS_Timeout:
+			return "eLeapRS_Timeout";
+		case eLeapRS_NotConnected:
+			return "eLeapRS_NotConnected";
+		case eLeapRS_HandshakeIncomplete:
+			return "eLeapRS_HandshakeIncomplete";
+		case eLeapRS_BufferSizeOverflow:
+			return "eLeapRS_BufferSizeOverflow";
+		case eLeapRS_ProtocolError:
+			return "eLeapRS_ProtocolError";
+		case eLeapRS_InvalidClientID:
+			return "eLeapRS_InvalidClientID";
+		case eLeapRS_UnexpectedClosed:
+			return "eLeapRS_UnexpectedClosed";
+		case eLeapRS_UnknownImageFrameRequest:
+			return "eLeapRS_UnknownImageFrameRequest";
+		case eLeapRS_UnknownTrackingFrameID:
+			return "eLeapRS_UnknownTrackingFrameID";
+		case eLeapRS_RoutineIsNotSeer:
+			return "eLeapRS_RoutineIsNotSeer";
+		case eLeapRS_TimestampTooEarly:
+			return "eLeapRS_TimestampTooEarly";
+		case eLeapRS_ConcurrentPoll:
+			return "eLeapRS_ConcurrentPoll";
+		case eLeapRS_NotAvailable:
+			return "eLeapRS_NotAvailable";
+		case eLeapRS_NotStreaming:
+			return "eLeapRS_NotStreaming";
+		case eLeapRS_CannotOpenDevice:
+			return "eLeapRS_CannotOpenDevice";
+		default:
+			return "unknown result type.";
+		}
+	}
+
+	LeapLogRing::LeapLogRing(UINT32 capacity)
+		: mRecords(capacity)
+	{ }
+
+	void LeapLogRing::post(LeapLogCode code, eLeapLogSeverity severity, INT32 value, const char* payload)
+	{
+		push(code, severity, value, LeapGetNow(), payload);
+	}
+
+	void LeapLogRing::postServiceMessage(eLeapLogSeverity severity, INT64 timestamp, const char* message)
+	{
+		push(LeapLogCode::ServiceMessage, severity, 0, timestamp, message);
+	}
+
+	void LeapLogRing::push(LeapLogCode code, eLeapLogSeverity severity, INT32 value, INT64 timestamp,
+		const char* payload)
+	{
+		LeapLogRecord record;
+		record.mCode = code;
+		record.mSeverity = severity;
+		record.mValue = value;
+		record.mTimestamp = timestamp;
+
+		if (payload != NULL)
+		{
+			strncpy(record.mPayload, payload, LeapLogRecord::PAYLOAD_SIZE - 1);
+			record.mPayload[LeapLogRecord::PAYLOAD_SIZE - 1] = '\0';
+		}
+		else
+			record.mPayload[0] = '\0';
+
+		if (!mRecords.tryPush(record))
+			mNumDropped.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	bool LeapLogRing::checkRepeat(const LeapLogRecord& record, UINT32& numSuppressed)
+	{
+		UINT32 value = (UINT32)record.mValue;
+		if (record.mCode == LeapLogCode::ServiceMessage)
+		{
+			// FNV-1a of the text, the service doesn't number its messages
+			value = 2166136261U;
+			for (const char* c = record.mPayload; *c != '\0'; c++)
+				value = (value ^ (UINT8)*c) * 16777619U;
+		}
+
+		UINT64 key = ((UINT64)record.mCode << 32) | value;
+		auto found = mRepeats.find(key);
+		if (found != mRepeats.end())
+		{
+			RepeatState& repeat = found->second;
+			if (record.mTimestamp - repeat.mLastWritten < REPEAT_INTERVAL)
+			{
+				repeat.mNumSuppressed++;
+				mNumSuppressed++;
+				return false;
+			}
+
+			numSuppressed = repeat.mNumSuppressed;
+			repeat.mLastWritten = record.mTimestamp;
+			repeat.mNumSuppressed = 0;
+			return true;
+		}
+
+		// Service messages may embed varying values, don't let their states pile up
+		if (mRepeats.size() >= MAX_REPEAT_STATES)
+		{
+			for (auto iter = mRepeats.begin(); iter != mRepeats.end();)
+			{
+				if (record.mTimestamp - iter->second.mLastWritten >= REPEAT_INTERVAL)
+					iter = mRepeats.erase(iter);
+				else
+					++iter;
+			}
+		}
+
+		RepeatState& repeat = mRepeats[key];
+		repeat.mLastWritten = record.mTimestamp;
+
+		numSuppressed = 0;
+		return true;
+	}
+
+	void LeapLogRing::write(const LeapLogRecord& record, UINT32 numSuppressed)
+	{
+		String message;
+		switch (record.mCode)
+		{
+		case LeapLogCode::PollFailed:
+			message = "LeapPollConnection call was " + toString((eLeapRS)record.mValue);
+			break;
+		case LeapLogCode::OpenDeviceFailed:
+			message = "Could not open device " + toString((eLeapRS)record.mValue);
+			break;
+		case LeapLogCode::DeviceInfoFailed:
+			message = "Failed to get device info " + toString((eLeapRS)record.mValue);
+			break;
+		case LeapLogCode::UnhandledMessage:
+			message = "Unhandled message type " + toString(record.mValue);
+			break;
+		case LeapLogCode::Reconnecting:
+			message = "Leap Motion service not connected, reconnecting (attempt " + toString(record.mValue) + ")";
+			break;
+		default:
+			message = record.mPayload;
+			break;
+		}
+
+		if (numSuppressed > 0)
+			message += " (repeated " + toString(numSuppressed) + " more times)";
+
+		switch (record.mSeverity)
+		{
+		case eLeapLogSeverity_Critical:
+			LOGERR(message);
+			break;
+		case eLeapLogSeverity_Warning:
+			LOGWRN(message);
+			break;
+		default:
+			LOGDBG(message);
+			break;
+		}
+	}
+}
\ No newline at end of file
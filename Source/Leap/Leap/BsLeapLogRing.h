@@ -0,0 +1,143 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+#include "Utility/BsBoundedQueue.h"
+
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	/** Returns a human readable name of a LeapC result code. */
+	String toString(eLeapRS result);
+
+	/** Identifies the message of a LeapLogRecord. */
+	enum class LeapLogCode
+	{
+		/** LeapPollConnection() failed. The value holds the eLeapRS result. */
+		PollFailed,
+		/** LeapOpenDevice() failed. The value holds the eLeapRS result. */
+		OpenDeviceFailed,
+		/** LeapGetDeviceInfo() failed. The value holds the eLeapRS result. */
+		DeviceInfoFailed,
+		/** LeapPollConnection() returned a message type that isn't handled. The value holds the eLeapEventType. */
+		UnhandledMessage,
+		/** The connection was lost and is being reopened. The value holds the number of the attempt. */
+		Reconnecting,
+		/** A log message sent by the Leap Motion service. The payload holds the (possibly truncated) message text. */
+		ServiceMessage
+	};
+
+	/** Fixed size log entry, recorded without allocating. */
+	struct LeapLogRecord
+	{
+		/** Maximum length of the inline payload, including the null terminator. */
+		static constexpr UINT32 PAYLOAD_SIZE = 96;
+
+		LeapLogCode mCode = LeapLogCode::ServiceMessage;
+		eLeapLogSeverity mSeverity = eLeapLogSeverity_Unknown;
+
+		/** Numeric argument of the message, meaning depends on mCode. */
+		INT32 mValue = 0;
+
+		/** Time at which the message was recorded, in microseconds on the LeapC clock. */
+		INT64 mTimestamp = 0;
+
+		/** Null terminated text argument of the message, meaning depends on mCode. */
+		char mPayload[PAYLOAD_SIZE];
+	};
+
+	/**
+	 * Bounded log of messages raised on the LeapC message pump thread. Recording a message only copies a fixed size
+	 * record into a lock-free ring, without formatting, allocating or taking the engine log lock, so logging can't
+	 * slow down frame intake. The ring is drained on the main thread, where the messages are formatted and written to
+	 * the engine log. Repeats of the same message are rate limited so a flapping service can't flood the log.
+	 */
+	class LeapLogRing
+	{
+	public:
+		/** Constructs a log able to hold @p capacity records waiting to be drained. */
+		LeapLogRing(UINT32 capacity);
+
+		/**
+		 * Records a message. Never blocks, if the ring is full the message is dropped and counted. Must only be called from
+		 * the LeapC message pump thread, or while it is stopped.
+		 *
+		 * @param code		Identifies the message.
+		 * @param severity	Severity of the message.
+		 * @param value		Numeric argument of the message.
+		 * @param payload	Optional text argument of the message, truncated to fit the record.
+		 */
+		void post(LeapLogCode code, eLeapLogSeverity severity, INT32 value, const char* payload = NULL);
+
+		/** Records a log message sent by the Leap Motion service, keeping its own timestamp. Same rules as post(). */
+		void postServiceMessage(eLeapLogSeverity severity, INT64 timestamp, const char* message);
+
+		/**
+		 * Empties the ring. Records with LeapLogCode::ServiceMessage are passed to @p forward, all others are formatted
+		 * and written to the engine log. Both go through the same rate limit. Must only be called from the main thread.
+		 */
+		template<class F>
+		void drain(F forward)
+		{
+			LeapLogRecord record;
+			while (mRecords.tryPop(record))
+			{
+				UINT32 numSuppressed;
+				if (!checkRepeat(record, numSuppressed))
+					continue;
+
+				if (record.mCode == LeapLogCode::ServiceMessage)
+					forward(record);
+				else
+					write(record, numSuppressed);
+			}
+		}
+
+		/** Returns the number of records dropped because the ring was full. */
+		UINT64 getNumDropped() const { return mNumDropped.load(std::memory_order_relaxed); }
+
+		/** Returns the number of records not written or forwarded because they repeated too quickly. */
+		UINT64 getNumSuppressed() const { return mNumSuppressed; }
+
+	private:
+		/** Minimum time between two writes of the same message to the engine log, in microseconds. */
+		static constexpr INT64 REPEAT_INTERVAL = 1000000;
+
+		/** Number of messages tracked by the rate limit past which those that stopped repeating are forgotten. */
+		static constexpr UINT32 MAX_REPEAT_STATES = 256;
+
+		/** Rate limiting state of a single message. */
+		struct RepeatState
+		{
+			INT64 mLastWritten = 0;
+			UINT32 mNumSuppressed = 0;
+		};
+
+		/** Adds a record to the ring, or counts it as dropped if the ring is full. */
+		void push(LeapLogCode code, eLeapLogSeverity severity, INT32 value, INT64 timestamp, const char* payload);
+
+		/**
+		 * Returns false if @p record repeats a message let through less than REPEAT_INTERVAL ago. Otherwise returns true
+		 * and outputs in @p numSuppressed how many repeats of the message were dropped since it was last let through.
+		 * Messages of the service are told apart by their text, all others by their code and value.
+		 */
+		bool checkRepeat(const LeapLogRecord& record, UINT32& numSuppressed);
+
+		/** Formats a record and writes it to the engine log. */
+		void write(const LeapLogRecord& record, UINT32 numSuppressed);
+
+		BoundedQueue<LeapLogRecord> mRecords;
+		std::atomic<UINT64> mNumDropped{ 0 };
+
+		UnorderedMap<UINT64, RepeatState> mRepeats;
+		UINT64 mNumSuppressed = 0;
+	};
+
+	/** @} */
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapRigBinding.h"
+
+namespace bs
+{
+	UINT32 LeapRigBinding::addJoint(const String& path)
+	{
+		Joint joint;
+
+		size_t start = 0;
+		while (start <= path.size())
+		{
+			size_t end = path.find('/', start);
+			if (end == String::npos)
+				end = path.size();
+
+			if (end > start)
+				joint.mPath.push_back(path.substr(start, end - start));
+
+			start = end + 1;
+		}
+
+		mJoints.push_back(joint);
+		mIsDirty = true;
+		return (UINT32)mJoints.size() - 1;
+	}
+
+	UINT32 LeapRigBinding::addJoint(const HSceneObject& sceneObject)
+	{
+		Joint joint;
+		joint.mSceneObject = sceneObject;
+
+		mJoints.push_back(joint);
+		mIsDirty = true;
+		return (UINT32)mJoints.size() - 1;
+	}
+
+	void LeapRigBinding::clear()
+	{
+		mJoints.clear();
+		mIsDirty = true;
+	}
+
+	void LeapRigBinding::bind(const HSceneObject& root)
+	{
+		for (auto& joint : mJoints)
+		{
+			if (!joint.mPath.empty())
+			{
+				HSceneObject sceneObject = root;
+				for (auto& name : joint.mPath)
+				{
+					if (sceneObject == NULL || sceneObject.isDestroyed())
+						break;
+
+					sceneObject = sceneObject->findChild(name);
+				}
+
+				joint.mSceneObject = sceneObject;
+			}
+
+			// Users only check for null, destroyed scene objects are dropped so that they read as missing
+			joint.mIsResolved = joint.mSceneObject != NULL && !joint.mSceneObject.isDestroyed();
+			if (!joint.mIsResolved)
+				joint.mSceneObject = HSceneObject();
+		}
+
+		mIsDirty = false;
+		mVersion++;
+	}
+
+	bool LeapRigBinding::needsBind() const
+	{
+		if (mIsDirty)
+			return true;
+
+		for (auto& joint : mJoints)
+		{
+			if (joint.mIsResolved && joint.mSceneObject.isDestroyed())
+				return true;
+		}
+
+		return false;
+	}
+}
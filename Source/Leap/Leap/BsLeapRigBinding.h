@@ -0,0 +1,72 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+#include "Scene/BsSceneObject.h"
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	/**
+	 * Scene objects driven by a hand model, resolved once instead of being looked up every frame. Joints are either found
+	 * by their path below the root of the rig, or assigned directly.
+	 *
+	 * The binding only needs to be resolved again when the hierarchy changes: when it is invalidated, or when one of the
+	 * resolved scene objects was destroyed, which needsBind() detects with a check per joint.
+	 */
+	class LeapRigBinding
+	{
+	public:
+		/**
+		 * Adds a joint found by following @p path from the root of the rig. The path is a list of child names separated
+		 * by '/', each of them searched recursively below the previous one. Returns the index of the joint.
+		 */
+		UINT32 addJoint(const String& path);
+
+		/** Adds a joint bound to @p sceneObject, which may be null. Returns the index of the joint. */
+		UINT32 addJoint(const HSceneObject& sceneObject);
+
+		/** Removes every joint. */
+		void clear();
+
+		/** Resolves the joints found by path against @p root, and forgets the joints that were destroyed. */
+		void bind(const HSceneObject& root);
+
+		/** Marks the binding as out of date, for example because the hierarchy of the rig changed. */
+		void invalidate() { mIsDirty = true; }
+
+		/** Returns true if the binding was never resolved, was invalidated, or lost a joint since it was resolved. */
+		bool needsBind() const;
+
+		/** Returns the scene object of a joint, or null if it could not be resolved. */
+		const HSceneObject& getJoint(UINT32 index) const { return mJoints[index].mSceneObject; }
+
+		/** Returns the number of joints. */
+		UINT32 getNumJoints() const { return (UINT32)mJoints.size(); }
+
+		/**
+		 * Returns a number incremented every time the binding is resolved. Lets users cache state derived from the joints,
+		 * like their components, for as long as the binding doesn't change.
+		 */
+		UINT32 getVersion() const { return mVersion; }
+
+	private:
+		struct Joint
+		{
+			/** Names of the children to follow from the root. Empty for joints assigned directly. */
+			Vector<String> mPath;
+			HSceneObject mSceneObject;
+			bool mIsResolved = false;
+		};
+
+		Vector<Joint> mJoints;
+		bool mIsDirty = true;
+		UINT32 mVersion = 0;
+	};
+
+	/** @} */
+}
@@ -3,65 +3,18 @@
 
 #include "Leap/BsLeapService.h"
 #include "Leap/BsLeapFrame.h"
+#include "Utility/BsTime.h"
 
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <thread>
 
 namespace bs
 {
-	static String toString(eLeapRS r)
-	{
-		switch (r)
-		{
-		case eLeapRS_Success:
-			return "eLeapRS_Success";
-		case eLeapRS_UnknownError:
-			return "eLeapRS_UnknownError";
-		case eLeapRS_InvalidArgument:
-			return "eLeapRS_InvalidArgument";
-		case eLeapRS_InsufficientResources:
-			return "eLeapRS_InsufficientResources";
-		case eLeapRS_InsufficientBuffer:
-			return "eLeapRS_InsufficientBuffer";
-		case eLeapRS_Timeout:
-			return "eLeapRS_Timeout";
-		case eLeapRS_NotConnected:
-			return "eLeapRS_NotConnected";
-		case eLeapRS_HandshakeIncomplete:
-			return "eLeapRS_HandshakeIncomplete";
-		case eLeapRS_BufferSizeOverflow:
-			return "eLeapRS_BufferSizeOverflow";
-		case eLeapRS_ProtocolError:
-			return "eLeapRS_ProtocolError";
-		case eLeapRS_InvalidClientID:
-			return "eLeapRS_InvalidClientID";
-		case eLeapRS_UnexpectedClosed:
-			return "eLeapRS_UnexpectedClosed";
-		case eLeapRS_UnknownImageFrameRequest:
-			return "eLeapRS_UnknownImageFrameRequest";
-		case eLeapRS_UnknownTrackingFrameID:
-			return "eLeapRS_UnknownTrackingFrameID";
-		case eLeapRS_RoutineIsNotSeer:
-			return "eLeapRS_RoutineIsNotSeer";
-		case eLeapRS_TimestampTooEarly:
-			return "eLeapRS_TimestampTooEarly";
-		case eLeapRS_ConcurrentPoll:
-			return "eLeapRS_ConcurrentPoll";
-		case eLeapRS_NotAvailable:
-			return "eLeapRS_NotAvailable";
-		case eLeapRS_NotStreaming:
-			return "eLeapRS_NotStreaming";
-		case eLeapRS_CannotOpenDevice:
-			return "eLeapRS_CannotOpenDevice";
-		default:
-			return "unknown result type.";
-		}
-	}
-
-	LeapService::LeapService()
-		: mFrames(_frameBufferLength)
+	LeapService::LeapService(UINT32 maxHands)
+		: mFrames(_frameBufferLength, maxHands), mDispatcher(mFrames, EVENT_QUEUE_CAPACITY),
+		mLog(LOG_RING_CAPACITY), mConnectionMonitor(std::bind(&LeapService::checkConnection, this),
+			std::bind(&LeapService::reconnect, this, std::placeholders::_1))
 	{
 		assert(sizeof(LEAP_VECTOR) == sizeof(Vector3));
 		assert(sizeof(LEAP_QUATERNION) == sizeof(Quaternion));
@@ -70,9 +23,61 @@ namespace bs
 		assert(sizeof(LEAP_PALM) == sizeof(LeapPalm));
 		assert(sizeof(LEAP_HAND) == sizeof(LeapHand));
 		assert(sizeof(LEAP_TRACKING_EVENT) == sizeof(LeapFrame));
+
+		mFrameCache.reserveNumberOfHands(maxHands);
+		mSmoothedTrackingLatency.setBlend(0.99f, 0.0111f);
 	}
 
 	void LeapService::startConnection()
+	{
+		{
+			Lock lock(mConnectionMutex);
+			openConnection();
+		}
+
+		// Started even if opening failed, so the connection is retried
+		mConnectionMonitor.start();
+	}
+
+	void LeapService::stopConnection()
+	{
+		// Stopped first, so it can't reopen the connection behind our back
+		mConnectionMonitor.stop();
+
+		Lock lock(mConnectionMutex);
+		closeConnection();
+	}
+
+	void LeapService::acquireSession()
+	{
+		Lock lock(mSessionMutex);
+
+		// Does nothing if the connection was already started by another session
+		if (mNumSessions++ == 0)
+			startConnection();
+	}
+
+	void LeapService::releaseSession()
+	{
+		Lock lock(mSessionMutex);
+
+		if (mNumSessions == 0)
+		{
+			LOGWRN("Releasing a session that was never acquired.");
+			return;
+		}
+
+		if (--mNumSessions == 0)
+			stopConnection();
+	}
+
+	UINT32 LeapService::getNumSessions() const
+	{
+		Lock lock(mSessionMutex);
+		return mNumSessions;
+	}
+
+	void LeapService::openConnection()
 	{
 		if (mIsRunning)
 			return;
@@ -94,19 +99,24 @@ namespace bs
 			return;
 		}
 
-		if (mAllocator.allocate == NULL)
+		if (mAllocatorMode == AllocatorMode::Pooled)
+			mAllocator = mSlabAllocator.getLeapAllocator();
+		else
+		{
 			mAllocator.allocate = bs_leap_alloc;
-
-		if (mAllocator.deallocate == NULL)
 			mAllocator.deallocate = bs_leap_free;
+			mAllocator.state = NULL;
+		}
 
 		LeapSetAllocator(mConnection, &mAllocator);
 
+		mMonitor.resetFrameSequence();
+
 		mIsRunning = true;
 		mThread = bs_new<Thread>(std::bind(&LeapService::processMessageLoop, this));
 	}
 
-	void LeapService::stopConnection()
+	void LeapService::closeConnection()
 	{
 		if (!mIsRunning)
 			return;
@@ -124,16 +134,75 @@ namespace bs
 		LeapCloseConnection(mConnection);
 
 		mThread->join();
+		mDispatcher.waitForWorker();
+
+		// Release threads blocked in waitForFrame(), no new frames will arrive
+		{
+			Lock lock(mFrameWaitMutex);
+		}
+		mFrameWaitSignal.notify_all();
+
+		// The message pump is stopped, so nothing else updates the status. Device handles don't survive the connection.
+		mIsConnected = false;
+		{
+			Lock lock(mDevicesMutex);
+			mDevices.clear();
+		}
+		updateConnectionStatus();
+	}
+
+	bool LeapService::checkConnection()
+	{
+		// The message pump keeps the status current, LeapC is only asked to catch a connection dying silently
+		if (getConnectionStatus() == ConnectionStatus::Disconnected)
+			return false;
+
+		return isServiceConnected();
+	}
+
+	void LeapService::reconnect(UINT32 attempt)
+	{
+		Lock lock(mConnectionMutex);
+		closeConnection();
+
+		// Only the message pump thread posts to the log while it is running
+		mLog.post(LeapLogCode::Reconnecting, eLeapLogSeverity_Warning, (INT32)attempt);
+
+		openConnection();
+	}
+
+	void LeapService::updateConnectionStatus()
+	{
+		ConnectionStatus status = ConnectionStatus::Disconnected;
+		if (mIsConnected)
+		{
+			Lock lock(mDevicesMutex);
+			status = mDevices.empty() ? ConnectionStatus::ServiceConnected : ConnectionStatus::Connected;
+		}
+
+		mConnectionStatus.store(status, std::memory_order_release);
 	}
 
 	void LeapService::destroyConnection()
 	{
 		stopConnection();
-		LeapDestroyConnection(mConnection);
+
+		if (mConnection != NULL)
+		{
+			LeapDestroyConnection(mConnection);
+			mConnection = NULL;
+		}
+	}
+
+	Map<LeapDeviceHandle, SPtr<LeapDevice>> LeapService::getDevices() const
+	{
+		Lock lock(mDevicesMutex);
+		return mDevices;
 	}
 
 	SPtr<LeapDevice> LeapService::getDeviceActive() const
 	{
+		Lock lock(mDevicesMutex);
 		auto itFind = std::find_if(mDevices.begin(), mDevices.end(), [&](auto& x) { return x.second->isStreaming(); });
 		if (itFind != mDevices.end())
 			return itFind->second;
@@ -151,27 +220,76 @@ namespace bs
 		return LeapGetNow();
 	}
 
-	bool LeapService::hasFrame(UINT32 history)
+	void LeapService::updateClocks()
 	{
-		Lock lock(mMutex);
+		UINT64 frameIdx = gTime().getFrameIdx();
+		if (frameIdx == mClockFrameIdx)
+			return;
+
+		mClockFrameIdx = frameIdx;
+
+		// Sampled every frame, even while disconnected, so the mapping follows pauses and slow downs of the engine clock
+		mFrameTime = gTime().getTimePrecise();
+		mClockSync.update((INT64)mFrameTime, getNow());
 
+		if (!isConnected() || !hasFrame())
+			return;
+
+		float trackingLatency = (float)(getNow() - getFrameTimestamp());
+		mSmoothedTrackingLatency.mValue = std::min(mSmoothedTrackingLatency.mValue, 30000.0f);
+		mSmoothedTrackingLatency.update(trackingLatency, gTime().getFrameDelta());
+	}
+
+	bool LeapService::hasFrame(UINT32 history)
+	{
 		return history < mFrames.size();
 	}
 
-	const LeapFrame& LeapService::getFrame(UINT32 history)
+	bool LeapService::getFrame(LeapFrameAlloc* toFill, UINT32 history)
 	{
-		Lock lock(mMutex);
+		return mFrames.read(history, *toFill);
+	}
+
+	bool LeapService::waitForFrame(UINT64& numFramesSeen, INT64 deadline, LeapFrameAlloc* toFill)
+	{
+		if (mNumFramesPublished.load() <= numFramesSeen)
+		{
+			// The waiter count and the frame count are both sequentially consistent, so either pushFrame() sees this
+			// waiter or the check below sees the new frame
+			mNumFrameWaiters.fetch_add(1);
+			{
+				Lock lock(mFrameWaitMutex);
+				while (mNumFramesPublished.load() <= numFramesSeen && mIsRunning)
+				{
+					INT64 remaining = deadline - LeapGetNow();
+					if (remaining <= 0)
+						break;
+
+					mFrameWaitSignal.wait_for(lock, std::chrono::microseconds(remaining));
+				}
+			}
+			mNumFrameWaiters.fetch_sub(1);
+		}
 
-		LeapFrame& frame = mFrames[history];
-		return frame;
+		// Serials count pushes from zero, so the frame read always matches the count returned with it. Retried in the
+		// unlikely case the whole history was rewritten between loading the count and reading the frame.
+		while (true)
+		{
+			UINT64 numFramesPublished = mNumFramesPublished.load();
+			if (numFramesPublished <= numFramesSeen)
+				return false;
+
+			if (mFrames.readSerial(numFramesPublished - 1, *toFill))
+			{
+				numFramesSeen = numFramesPublished;
+				return true;
+			}
+		}
 	}
 
 	INT64 LeapService::getFrameTimestamp(UINT32 history)
 	{
-		Lock lock(mMutex);
-
-		LeapFrame& frame = mFrames[history];
-		return frame.mInfo.timestamp;
+		return mFrames.readTimestamp(history);
 	}
 
 	bool LeapService::getInterpolatedFrameSize(INT64 timestamp, UINT64& size)
@@ -227,6 +345,58 @@ namespace bs
 		return true;
 	}
 
+	bool LeapService::getFrameAt(INT64 timestamp, LeapFrameAlloc* toFill)
+	{
+		// Kept per thread so its buffers are reused between calls, and consecutive calls between the same frames share
+		// the interpolation setup
+		static thread_local LeapFrameInterpolator interpolator;
+
+		return getFrameAt(timestamp, toFill, interpolator);
+	}
+
+	bool LeapService::getFrameAt(INT64 timestamp, LeapFrameAlloc* toFill, LeapFrameInterpolator& interpolator)
+	{
+		// Bracketing history frames never change once pushed, so a held pair stays valid for as long as it's needed
+		if (!interpolator.contains(timestamp) && !interpolator.reset(mFrames, timestamp))
+			return getInterpolatedFrame(timestamp, toFill);
+
+		interpolator.evaluate(timestamp, *toFill);
+		return true;
+	}
+
+	bool LeapService::getSharedFrameAt(INT64 timestamp, UINT64 tick, LeapFrameAlloc* toFill,
+		LeapFrameInterpolator& interpolator)
+	{
+		// Frames interpolated in process are their own source
+		if (mFrameCache.find(tick, timestamp, timestamp, *toFill))
+			return true;
+
+		if (!getFrameAt(timestamp, toFill, interpolator))
+			return false;
+
+		mFrameCache.store(tick, timestamp, timestamp, *toFill);
+		return true;
+	}
+
+	bool LeapService::getSharedInterpolatedFrameFromTime(INT64 time, INT64 sourceTime, UINT64 tick,
+		LeapFrameAlloc* toFill)
+	{
+		if (mFrameCache.find(tick, time, sourceTime, *toFill))
+			return true;
+
+		if (!getInterpolatedFrameFromTime(time, sourceTime, toFill))
+			return false;
+
+		mFrameCache.store(tick, time, sourceTime, *toFill);
+		return true;
+	}
+
+	bool LeapService::getPredictedFrame(INT64 timestamp, LeapFrameAlloc* toFill, LeapFramePredictor& predictor)
+	{
+		predictor.update(mFrames);
+		return predictor.predict(timestamp, *toFill);
+	}
+
 	void LeapService::setPolicy(eLeapPolicyFlag policy)
 	{
 		UINT64 setFlags = (UINT64)policy;
@@ -251,7 +421,7 @@ namespace bs
 
 	bool LeapService::isConnected() const
 	{
-		return mIsConnected && mDevices.size() > 0;
+		return getConnectionStatus() == ConnectionStatus::Connected;
 	}
 
 	bool LeapService::isServiceConnected() const
@@ -260,19 +430,107 @@ namespace bs
 			return false;
 
 		LEAP_CONNECTION_INFO info;
+		info.size = sizeof(info);
 
 		eLeapRS result = LeapGetConnectionInfo(mConnection, &info);
 		if (result != eLeapRS_Success)
-			LOGERR("LeapGetConnectionInfo call was " + toString(result));
+			return false;
 
-		if (info.status == eLeapConnectionStatus_Connected)
-			return true;
+		return info.status == eLeapConnectionStatus_Connected;
+	}
+
+	HEvent LeapService::connectConnection(std::function<void(const LEAP_CONNECTION_EVENT*)> func,
+		LeapDeliveryPolicy policy)
+	{
+		if (policy == LeapDeliveryPolicy::Inline)
+			return onConnection.connect(func);
+
+		return mDispatcher.connectConnection(func, policy);
+	}
+
+	HEvent LeapService::connectConnectionLost(std::function<void(const LEAP_CONNECTION_LOST_EVENT*)> func,
+		LeapDeliveryPolicy policy)
+	{
+		if (policy == LeapDeliveryPolicy::Inline)
+			return onConnectionLost.connect(func);
+
+		return mDispatcher.connectConnectionLost(func, policy);
+	}
+
+	HEvent LeapService::connectDevice(std::function<void(const LEAP_DEVICE_EVENT*)> func, LeapDeliveryPolicy policy)
+	{
+		if (policy == LeapDeliveryPolicy::Inline)
+			return onDevice.connect(func);
+
+		return mDispatcher.connectDevice(func, policy);
+	}
+
+	HEvent LeapService::connectDeviceLost(std::function<void(const LEAP_DEVICE_EVENT*)> func,
+		LeapDeliveryPolicy policy)
+	{
+		if (policy == LeapDeliveryPolicy::Inline)
+			return onDeviceLost.connect(func);
+
+		return mDispatcher.connectDeviceLost(func, policy);
+	}
+
+	HEvent LeapService::connectDeviceFailure(std::function<void(const LEAP_DEVICE_FAILURE_EVENT*)> func,
+		LeapDeliveryPolicy policy)
+	{
+		if (policy == LeapDeliveryPolicy::Inline)
+			return onDeviceFailure.connect(func);
+
+		return mDispatcher.connectDeviceFailure(func, policy);
+	}
+
+	HEvent LeapService::connectDeviceStatusChange(std::function<void(const LEAP_DEVICE_STATUS_CHANGE_EVENT*)> func,
+		LeapDeliveryPolicy policy)
+	{
+		if (policy == LeapDeliveryPolicy::Inline)
+			return onDeviceStatusChange.connect(func);
+
+		return mDispatcher.connectDeviceStatusChange(func, policy);
+	}
+
+	HEvent LeapService::connectDroppedFrame(std::function<void(const LEAP_DROPPED_FRAME_EVENT*)> func,
+		LeapDeliveryPolicy policy)
+	{
+		if (policy == LeapDeliveryPolicy::Inline)
+			return onDroppedFrame.connect(func);
+
+		return mDispatcher.connectDroppedFrame(func, policy);
+	}
+
+	HEvent LeapService::connectPolicy(std::function<void(const UINT32)> func, LeapDeliveryPolicy policy)
+	{
+		if (policy == LeapDeliveryPolicy::Inline)
+			return onPolicy.connect(func);
+
+		return mDispatcher.connectPolicy(func, policy);
+	}
 
-		return false;
+	HEvent LeapService::connectFrame(std::function<void(const LeapFrame*)> func, LeapDeliveryPolicy policy)
+	{
+		if (policy == LeapDeliveryPolicy::Inline)
+			return onFrame.connect(func);
+
+		return mDispatcher.connectFrame(func, policy);
+	}
+
+	void LeapService::dispatchQueuedEvents()
+	{
+		mDispatcher.dispatchMainThread();
+
+		mLog.drain([this](const LeapLogRecord& record)
+		{
+			if (!onLogMessage.empty())
+				onLogMessage(record.mSeverity, record.mTimestamp, record.mPayload);
+		});
 	}
 
 	SPtr<LeapDevice> LeapService::findDeviceByHandle(LeapDeviceHandle handle) const
 	{
+		Lock lock(mDevicesMutex);
 		auto itFind = mDevices.find(handle);
 		if (itFind != mDevices.end())
 			return itFind->second;
@@ -280,10 +538,21 @@ namespace bs
 		return NULL;
 	}
 
-	void LeapService::pushFrame(const LeapFrame *frame)
+	UINT64 LeapService::pushFrame(const LeapFrame *frame, UINT32 gapBefore)
 	{
-		Lock lock(mMutex);
-		mFrames.push(*frame);
+		UINT64 serial = mFrames.push(*frame, gapBefore);
+		mNumFramesPublished.store(serial + 1);
+
+		if (mNumFrameWaiters.load() > 0)
+		{
+			// Taking the lock guarantees a waiter that just checked the frame id is already waiting on the signal
+			{
+				Lock lock(mFrameWaitMutex);
+			}
+			mFrameWaitSignal.notify_all();
+		}
+
+		return serial;
 	}
 
 	void LeapService::processMessageLoop()
@@ -297,7 +566,11 @@ namespace bs
 
 			if (result != eLeapRS_Success)
 			{
-				LOGWRN("LeapPollConnection call was " + toString(result));
+				// Timeouts only mean no message arrived, which is expected while no device is streaming
+				eLeapLogSeverity severity = result == eLeapRS_Timeout ? eLeapLogSeverity_Information :
+					eLeapLogSeverity_Warning;
+
+				mLog.post(LeapLogCode::PollFailed, severity, result);
 				continue;
 			}
 
@@ -318,6 +591,12 @@ namespace bs
 			case eLeapEventType_DeviceFailure:
 				handleOnDeviceFailure(msg.device_failure_event);
 				break;
+			case eLeapEventType_DeviceStatusChange:
+				handleOnDeviceStatusChange(msg.device_status_change_event);
+				break;
+			case eLeapEventType_DroppedFrame:
+				handleOnDroppedFrame(msg.dropped_frame_event);
+				break;
 			case eLeapEventType_Tracking:
 				handleOnTracking(msg.tracking_event);
 				break;
@@ -353,7 +632,7 @@ namespace bs
 				break;
 			default:
 				// discard unknown message types
-				printf("Unhandled message type %i.\n", msg.type);
+				mLog.post(LeapLogCode::UnhandledMessage, eLeapLogSeverity_Information, msg.type);
 			}
 		}
 	}
@@ -361,6 +640,13 @@ namespace bs
 	void LeapService::handleOnConnection(const LEAP_CONNECTION_EVENT* connectionEvent)
 	{
 		mIsConnected = true;
+		updateConnectionStatus();
+
+		LeapQueuedEvent event;
+		event.mType = LeapQueuedEventType::Connection;
+		event.mConnection = *connectionEvent;
+		mDispatcher.post(event);
+
 		if (!onConnection.empty())
 			onConnection(connectionEvent);
 	}
@@ -368,6 +654,13 @@ namespace bs
 	void LeapService::handleOnConnectionLost(const LEAP_CONNECTION_LOST_EVENT* connectionLostEvent)
 	{
 		mIsConnected = false;
+		updateConnectionStatus();
+
+		LeapQueuedEvent event;
+		event.mType = LeapQueuedEventType::ConnectionLost;
+		event.mConnectionLost = *connectionLostEvent;
+		mDispatcher.post(event);
+
 		if (!onConnectionLost.empty())
 			onConnectionLost(connectionLostEvent);
 	}
@@ -379,7 +672,7 @@ namespace bs
 		eLeapRS result = LeapOpenDevice(deviceEvent->device, &deviceHandle);
 		if (result != eLeapRS_Success)
 		{
-			printf("Could not open device %s.\n", toString(result));
+			mLog.post(LeapLogCode::OpenDeviceFailed, eLeapLogSeverity_Warning, result);
 			return;
 		}
 
@@ -392,22 +685,29 @@ namespace bs
 		result = LeapGetDeviceInfo(deviceHandle, &deviceInfo);
 		if (result != eLeapRS_Success)
 		{
-			printf("Failed to get device info %s.\n", toString(result));
+			mLog.post(LeapLogCode::DeviceInfoFailed, eLeapLogSeverity_Warning, result);
 			free(deviceInfo.serial);
 			return;
 		}
 
-		SPtr<LeapDevice> device = findDeviceByHandle(deviceHandle);
+		// Filled in before it is published, as other threads read the properties of published devices without locking.
+		// A device reported again replaces the previous instance rather than changing it under its readers.
+		SPtr<LeapDevice> device = bs_shared_ptr_new<LeapDevice>();
+		device->set(deviceHandle, deviceInfo.h_fov, deviceInfo.v_fov, deviceInfo.range / 1000.0f,
+			deviceInfo.baseline / 1000.0f, deviceInfo.pid, (deviceInfo.status == eLeapDeviceStatus_Streaming),
+			deviceInfo.serial);
+		device->setStatus(deviceInfo.status);
 
-		if (device == NULL)
 		{
-			device = bs_shared_ptr_new<LeapDevice>();
+			Lock lock(mDevicesMutex);
 			mDevices[deviceHandle] = device;
 		}
+		updateConnectionStatus();
 
-		device->set(deviceHandle, deviceInfo.h_fov, deviceInfo.v_fov, deviceInfo.range / 1000.0f,
-			deviceInfo.baseline / 1000.0f, deviceInfo.pid, (deviceInfo.status == eLeapDeviceStatus_Streaming),
-			deviceInfo.serial);
+		LeapQueuedEvent event;
+		event.mType = LeapQueuedEventType::Device;
+		event.mDevice = *deviceEvent;
+		mDispatcher.post(event);
 
 		if (!onDevice.empty())
 			onDevice(deviceEvent);
@@ -419,8 +719,17 @@ namespace bs
 
 	void LeapService::handleOnDeviceLost(const LEAP_DEVICE_EVENT* deviceEvent)
 	{
-		auto itFind = mDevices.find(deviceEvent->device.handle);
-		mDevices.erase(itFind);
+		{
+			Lock lock(mDevicesMutex);
+			mDevices.erase(deviceEvent->device.handle);
+		}
+
+		updateConnectionStatus();
+
+		LeapQueuedEvent event;
+		event.mType = LeapQueuedEventType::DeviceLost;
+		event.mDevice = *deviceEvent;
+		mDispatcher.post(event);
 
 		if (!onDeviceLost.empty())
 			onDeviceLost(deviceEvent);
@@ -449,18 +758,62 @@ namespace bs
 			break;
 		}
 
-		auto itFind = mDevices.find(deviceFailureEvent->hDevice);
-		if (itFind != mDevices.end())
-			mDevices.erase(itFind);
+		{
+			Lock lock(mDevicesMutex);
+			mDevices.erase(deviceFailureEvent->hDevice);
+		}
+
+		updateConnectionStatus();
+
+		LeapQueuedEvent event;
+		event.mType = LeapQueuedEventType::DeviceFailure;
+		event.mDeviceFailure = *deviceFailureEvent;
+		mDispatcher.post(event);
 
 		if (!onDeviceFailure.empty())
 			onDeviceFailure(deviceFailureEvent);
 	}
 
+	void LeapService::handleOnDeviceStatusChange(const LEAP_DEVICE_STATUS_CHANGE_EVENT* deviceStatusChangeEvent)
+	{
+		mMonitor.recordStatusChange(deviceStatusChangeEvent->last_status, deviceStatusChangeEvent->status);
+
+		SPtr<LeapDevice> device = findDeviceByHandle(deviceStatusChangeEvent->device.handle);
+		if (device != NULL)
+			device->setStatus(deviceStatusChangeEvent->status);
+
+		LeapQueuedEvent event;
+		event.mType = LeapQueuedEventType::DeviceStatusChange;
+		event.mDeviceStatusChange = *deviceStatusChangeEvent;
+		mDispatcher.post(event);
+
+		if (!onDeviceStatusChange.empty())
+			onDeviceStatusChange(deviceStatusChangeEvent);
+	}
+
+	void LeapService::handleOnDroppedFrame(const LEAP_DROPPED_FRAME_EVENT* droppedFrameEvent)
+	{
+		mMonitor.recordDroppedFrame(droppedFrameEvent->type);
+
+		LeapQueuedEvent event;
+		event.mType = LeapQueuedEventType::DroppedFrame;
+		event.mDroppedFrame = *droppedFrameEvent;
+		mDispatcher.post(event);
+
+		if (!onDroppedFrame.empty())
+			onDroppedFrame(droppedFrameEvent);
+	}
+
 	void LeapService::handleOnTracking(const LEAP_TRACKING_EVENT* trackingEvent)
 	{
 		const LeapFrame* frame = reinterpret_cast<const LeapFrame*>(trackingEvent);
-		pushFrame(frame);
+		UINT32 gapBefore = mMonitor.recordFrame(frame->mTrackingFrameId);
+		UINT64 serial = pushFrame(frame, gapBefore);
+
+		LeapQueuedEvent event;
+		event.mType = LeapQueuedEventType::Frame;
+		event.mFrameSerial = serial;
+		mDispatcher.post(event);
 
 		if (!onFrame.empty())
 			onFrame(frame);
@@ -469,7 +822,7 @@ namespace bs
 	void LeapService::handleOnLog(const LEAP_LOG_EVENT* logEvent)
 	{
 		if (!onLogMessage.empty())
-			onLogMessage(logEvent->severity, logEvent->timestamp, logEvent->message);
+			mLog.postServiceMessage(logEvent->severity, logEvent->timestamp, logEvent->message);
 	}
 
 	void LeapService::handleOnLogs(const LEAP_LOG_EVENTS* logEvents)
@@ -479,13 +832,18 @@ namespace bs
 			for (int i = 0; i < (int)(logEvents->nEvents); i++)
 			{
 				const LEAP_LOG_EVENT* logEvent = &logEvents->events[i];
-				onLogMessage(logEvent->severity, logEvent->timestamp, logEvent->message);
+				mLog.postServiceMessage(logEvent->severity, logEvent->timestamp, logEvent->message);
 			}
 		}
 	}
 
 	void LeapService::handleOnPolicy(const LEAP_POLICY_EVENT* policyEvent)
 	{
+		LeapQueuedEvent event;
+		event.mType = LeapQueuedEventType::Policy;
+		event.mPolicies = policyEvent->current_policy;
+		mDispatcher.post(event);
+
 		if (!onPolicy.empty())
 			onPolicy(policyEvent->current_policy);
 	}
@@ -520,11 +878,6 @@ namespace bs
 			onHeadPose(headPoseEvent);
 	}
 
-	void LeapService::onStartUp()
-	{
-		startConnection();
-	}
-
 	void LeapService::onShutDown()
 	{
 		destroyConnection();
@@ -2,12 +2,22 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #pragma once
 
+#include "Leap/BsLeapClockSync.h"
+#include "Leap/BsLeapConnectionMonitor.h"
 #include "Leap/BsLeapDevice.h"
+#include "Leap/BsLeapEventDispatcher.h"
 #include "Leap/BsLeapFrameAlloc.h"
+#include "Leap/BsLeapFrameCache.h"
 #include "Leap/BsLeapFrame.h"
-#include "Utility/BsCircularBuffer.h"
+#include "Leap/BsLeapFrameHistory.h"
+#include "Leap/BsLeapFrameInterpolator.h"
+#include "Leap/BsLeapFramePredictor.h"
+#include "Leap/BsLeapLogRing.h"
+#include "Leap/BsLeapSlabAllocator.h"
+#include "Leap/BsLeapTrackingMonitor.h"
 #include "Utility/BsEvent.h"
 #include "Utility/BsModule.h"
+#include "Utility/BsSmoothedFloat.h"
 
 namespace bs
 {
@@ -24,31 +34,98 @@ namespace bs
 	 * to 60 frames in its frame history.
 	 *
 	 * Polling is an appropriate strategy for applications which already have an intrinsic update loop, such as a game.
-	 * You can also subscribe to the onFrame event to get tracking frames through an event delegate.
+	 * You can also subscribe to the onFrame event to get tracking frames through an event delegate. Threads without an
+	 * update loop that want every frame as soon as it arrives can block in waitForFrame() instead.
+	 *
+	 * Subscribers to the public events are called on the LeapC message pump thread and delay the processing of the next
+	 * message until they return. Use the connect* methods with a LeapDeliveryPolicy to have events queued and delivered
+	 * on the main thread or on the worker pool instead. Events without a connect* method, like onImage, can only be
+	 * subscribed to inline.
 	 *
 	 * Note that any physical quantities and directions obtained from the Leap tracking data are relative to the Leap
 	 * Motion coordinate system, which uses a right-handed axes and units of millimeters.
+	 *
+	 * The frame history is written by the LeapC message pump thread and can be read from any thread without blocking it.
+	 *
+	 * Starting the module doesn't connect to the service. The connection only lives while at least one user holds a
+	 * session, see acquireSession(). CLeapServiceProvider does so for as long as it is alive.
 	 */
 	class LeapService : public Module<LeapService>
 	{
 	public:
-		/** Leap service constructor. */
-		LeapService();
+		/** Determines where LeapC gets the memory for the buffers it hands back to the client. */
+		enum class AllocatorMode
+		{
+			/** Every LeapC allocation goes to the heap. */
+			Heap,
+			/** LeapC allocations are recycled through a LeapSlabAllocator. */
+			Pooled
+		};
+
+		/** Status of the connection to the Leap Motion service. */
+		enum class ConnectionStatus
+		{
+			/** Not connected to the service. */
+			Disconnected,
+			/** Connected to the service, but no device is attached. */
+			ServiceConnected,
+			/** Connected to the service with at least one device attached. */
+			Connected
+		};
+
+		/**
+		 * Leap service constructor.
+		 *
+		 * @param maxHands	Maximum number of hands stored per frame in the frame history. Storage for them is allocated
+		 *					up front so that caching a new frame never allocates.
+		 */
+		LeapService(UINT32 maxHands = DEFAULT_MAX_HANDS);
 
 		/**
 		 * Creates and opens a connection to the Leap Motion service.
 		 * On success, creates a thread to service the LeapC message pump.
+		 *
+		 * Also starts a thread monitoring the health of the connection, which reopens it with an exponential backoff
+		 * whenever it is lost. The frame history and event subscriptions are kept across reconnections.
 		 */
 		void startConnection();
 
-		/** Closes a previously opened connection. */
+		/** Closes a previously opened connection, and stops monitoring it. */
 		void stopConnection();
 
+		/**
+		 * Registers a user of the connection, starting it if no other user holds a session. Every call must be matched by
+		 * a call to releaseSession(), users sharing the service should use these instead of starting and stopping the
+		 * connection.
+		 */
+		void acquireSession();
+
+		/** Unregisters a user of the connection. The connection is stopped once the last user is gone. */
+		void releaseSession();
+
+		/** Returns the number of users registered through acquireSession(). */
+		UINT32 getNumSessions() const;
+
 		/** Destroys a previously opened connection. */
 		void destroyConnection();
 
-		/** The map of currently attached and recognized Leap Motion devices. */
-		const Map<LeapDeviceHandle, SPtr<LeapDevice>>& getDevices() const { return mDevices; }
+		/** Sets the allocator used by LeapC. Takes effect the next time a connection is started. */
+		void setAllocatorMode(AllocatorMode mode) { mAllocatorMode = mode; }
+
+		/** Returns the allocator used by LeapC. */
+		AllocatorMode getAllocatorMode() const { return mAllocatorMode; }
+
+		/** Returns the maximum number of hands stored per frame in the frame history. */
+		UINT32 getMaxHands() const { return mFrames.getMaxHands(); }
+
+		/** Returns the pool serving LeapC allocations when AllocatorMode::Pooled is used. */
+		const LeapSlabAllocator& getSlabAllocator() const { return mSlabAllocator; }
+
+		/**
+		 * Returns the currently attached and recognized Leap Motion devices. The map is a copy, the devices can change on
+		 * the message pump and connection monitor threads at any time.
+		 */
+		Map<LeapDeviceHandle, SPtr<LeapDevice>> getDevices() const;
 
 		/** The device that is currently streaming tracking data. */
 		SPtr<LeapDevice> getDeviceActive() const;
@@ -59,6 +136,26 @@ namespace bs
 		/** Samples the universal clock used by the system to timestamp image and tracking frames. */
 		INT64 getNow();
 
+		/**
+		 * Samples the engine and Leap clocks and updates the smoothed tracking latency, once per engine frame. Every
+		 * provider calls it on update but only the first call of a frame does anything, so all of them map the same
+		 * engine time to the same Leap time and can share the frames of getSharedFrameAt(). Must be called from the main
+		 * thread.
+		 */
+		void updateClocks();
+
+		/** Returns the engine time sampled by updateClocks() for the current engine frame, in microseconds. */
+		UINT64 getFrameTime() const { return mFrameTime; }
+
+		/** Returns the mapping between the engine clock and the Leap clock, whose statistics can be monitored. */
+		const LeapClockSync& getClockSync() const { return mClockSync; }
+
+		/**
+		 * Returns the time between the capture of the newest tracking frame and its use, smoothed over the recent engine
+		 * frames, in microseconds.
+		 */
+		float getSmoothedTrackingLatency() const { return mSmoothedTrackingLatency.mValue; }
+
 		/** Returns if the service has a frame. Use the optional history parameter to specify which frame to retrieve. */
 		bool hasFrame(UINT32 history = 0);
 
@@ -69,14 +166,32 @@ namespace bs
 		 * Returns a frame of tracking data from the Leap Motion software. Use the optional history parameter to specify
 		 * which frame to retrieve. Call getFrame() or getFrame(0) to access the most recent frame; call getFrame(1) to
 		 * access the previous frame, and so on. If you use a history value greater than the number of stored frames,
-		 * then the controller returns an empty frame.
+		 * then no frame is returned.
 		 *
+		 * @param[out] toFill Receives a deep copy of the frame, including its hands, which remains valid regardless of
+		 * further tracking events.
 		 * @param history The age of the frame to return, counting backwards from the most recent frame (0) into the past
 		 * and up to the maximum age (59).
-		 * @returns The specified frame; or, if no history parameter is specified, the newest frame. If a frame is not
-		 * available at the specified history position, an invalid Frame is returned.
+		 * @returns True if a frame was available at the specified history position, false otherwise.
+		 */
+		bool getFrame(LeapFrameAlloc* toFill, UINT32 history = 0);
+
+		/**
+		 * Blocks the calling thread until a frame newer than the last one the caller has seen is received, or until the
+		 * deadline passes. The thread sleeps while waiting and is woken up as soon as the message pump thread publishes a
+		 * new frame.
+		 *
+		 * Frames are counted locally rather than identified by their ids, as the service starts its ids over when it
+		 * restarts and a caller holding an older id would otherwise wait until its deadline.
+		 *
+		 * @param[in,out] numFramesSeen Number of frames published when the caller last received one, 0 to accept any
+		 * frame. Updated to the count matching the returned frame, to be passed to the next call.
+		 * @param deadline Time at which to stop waiting, on the clock returned by getNow() (microseconds).
+		 * @param[out] toFill Receives a deep copy of the most recent frame, which is the first frame the caller hasn't
+		 * seen unless it fell behind.
+		 * @returns True if a newer frame was received, false if the deadline passed or the connection was stopped.
 		 */
-		const LeapFrame& getFrame(UINT32 history = 0);
+		bool waitForFrame(UINT64& numFramesSeen, INT64 deadline, LeapFrameAlloc* toFill);
 
 		/**
 		 * Returns the timestamp of a recent tracking frame.  Use the optional history parameter to specify how many frames
@@ -98,9 +213,71 @@ namespace bs
 
 		bool getInterpolatedFrameFromTime(INT64 time, INT64 sourceTime, LeapFrameAlloc* toFill);
 
+		/**
+		 * Returns the frame at the specified time. When the time is covered by the frame history the frame is
+		 * interpolated in process between the two enclosing frames, without a round trip to the Leap Motion service.
+		 * Otherwise falls back to getInterpolatedFrame().
+		 *
+		 * @param timestamp The time of the frame to return, on the clock returned by getNow().
+		 * @param[out] toFill Receives the frame.
+		 * @returns True if a frame could be computed, false otherwise.
+		 */
+		bool getFrameAt(INT64 timestamp, LeapFrameAlloc* toFill);
+
+		/**
+		 * Same as getFrameAt(INT64, LeapFrameAlloc*), but keeps the enclosing frames and the interpolation setup in
+		 * @p interpolator. Requests for times between the same two frames reuse them, which makes them much cheaper.
+		 * Callers sampling the same time range repeatedly, like fixed update sub-steps, should keep an interpolator
+		 * around.
+		 */
+		bool getFrameAt(INT64 timestamp, LeapFrameAlloc* toFill, LeapFrameInterpolator& interpolator);
+
+		/**
+		 * Same as getFrameAt(INT64, LeapFrameAlloc*, LeapFrameInterpolator&), but shares the frame with the other callers
+		 * asking for the same time during the same tick. Only the first of them computes it, the others get a copy.
+		 * Callers only ask for the same time if they derive it from getClockSync() and getSmoothedTrackingLatency().
+		 *
+		 * @param timestamp		The time of the frame to return, on the clock returned by getNow().
+		 * @param tick			Identifies the period during which frames are shared, usually the index of the engine frame.
+		 * @param[out] toFill	Receives the frame.
+		 * @param interpolator	Used when the frame needs to be computed.
+		 * @returns				True if a frame could be computed, false otherwise.
+		 */
+		bool getSharedFrameAt(INT64 timestamp, UINT64 tick, LeapFrameAlloc* toFill, LeapFrameInterpolator& interpolator);
+
+		/**
+		 * Same as getInterpolatedFrameFromTime(), but shares the frame with the other callers asking for the same times
+		 * during the same tick, like getSharedFrameAt().
+		 */
+		bool getSharedInterpolatedFrameFromTime(INT64 time, INT64 sourceTime, UINT64 tick, LeapFrameAlloc* toFill);
+
+		/** Returns the cache of frames shared by getSharedFrameAt() and getSharedInterpolatedFrameFromTime(). */
+		const LeapFrameCache& getFrameCache() const { return mFrameCache; }
+
+		/**
+		 * Returns the frame predicted at the specified time, which may be past the newest tracking frame. Compensates
+		 * for latency without the overshoot of the linear extrapolation done by the service.
+		 *
+		 * @param timestamp		The time of the frame to return, on the clock returned by getNow().
+		 * @param[out] toFill	Receives the frame.
+		 * @param predictor		Keeps the motion of the hands between calls. It is first updated with the frames received
+		 *						since the previous call, callers should keep it around.
+		 * @returns				True if a frame could be predicted, false if no frame was received yet.
+		 */
+		bool getPredictedFrame(INT64 timestamp, LeapFrameAlloc* toFill, LeapFramePredictor& predictor);
+
 		void setPolicy(eLeapPolicyFlag policy);
 		void clearPolicy(eLeapPolicyFlag policy);
 
+		/**
+		 * Returns the status of the connection to the Leap Motion service. Kept up to date by the message pump and
+		 * connection monitor threads, reading it costs a single atomic load.
+		 */
+		ConnectionStatus getConnectionStatus() const { return mConnectionStatus.load(std::memory_order_acquire); }
+
+		/** Returns how many times the connection was reopened after it was lost. */
+		UINT32 getNumReconnections() const { return mConnectionMonitor.getNumReconnections(); }
+
 		/**
 		 * Reports whether has a connection to the Leap Motion daemon/service.
 		 * Can be true even if the Leap Motion hardware is not available.
@@ -115,11 +292,86 @@ namespace bs
 		 */
 		bool isConnected() const;
 
+		/**
+		 * Returns how many times a reader of the frame history had to retry because the frame it was reading was being
+		 * overwritten by the message pump thread at the same time.
+		 */
+		UINT64 getFrameReadRetryCount() const { return mFrames.getReadRetryCount(); }
+
+		/**
+		 * Returns counters about frames dropped by the service, gaps in the received tracking frame ids and device status
+		 * changes. Growing drop counts of type eLeapDroppedFrameType_TrackingQueue mean frames are consumed too slowly.
+		 */
+		LeapTrackingMetrics getTrackingMetrics() const { return mMonitor.getMetrics(); }
+
+		/**
+		 * Returns the number of tracking frames missing between the frame at the specified history position and the one
+		 * before it.
+		 */
+		UINT32 getFrameGapBefore(UINT32 history = 0) const { return mFrames.readGapBefore(history); }
+
+		/** @name Subscription
+		 *  Subscribes to an event, delivered according to @p policy. LeapDeliveryPolicy::Inline is equivalent to
+		 *  connecting to the matching public event directly. The other public events have no such method and ignore
+		 *  delivery policies, see LeapDeliveryPolicy.
+		 *  @{
+		 */
+		HEvent connectConnection(std::function<void(const LEAP_CONNECTION_EVENT*)> func,
+			LeapDeliveryPolicy policy = LeapDeliveryPolicy::Inline);
+		HEvent connectConnectionLost(std::function<void(const LEAP_CONNECTION_LOST_EVENT*)> func,
+			LeapDeliveryPolicy policy = LeapDeliveryPolicy::Inline);
+		HEvent connectDevice(std::function<void(const LEAP_DEVICE_EVENT*)> func,
+			LeapDeliveryPolicy policy = LeapDeliveryPolicy::Inline);
+		HEvent connectDeviceLost(std::function<void(const LEAP_DEVICE_EVENT*)> func,
+			LeapDeliveryPolicy policy = LeapDeliveryPolicy::Inline);
+		HEvent connectDeviceFailure(std::function<void(const LEAP_DEVICE_FAILURE_EVENT*)> func,
+			LeapDeliveryPolicy policy = LeapDeliveryPolicy::Inline);
+		HEvent connectDeviceStatusChange(std::function<void(const LEAP_DEVICE_STATUS_CHANGE_EVENT*)> func,
+			LeapDeliveryPolicy policy = LeapDeliveryPolicy::Inline);
+		HEvent connectDroppedFrame(std::function<void(const LEAP_DROPPED_FRAME_EVENT*)> func,
+			LeapDeliveryPolicy policy = LeapDeliveryPolicy::Inline);
+		HEvent connectPolicy(std::function<void(const UINT32)> func,
+			LeapDeliveryPolicy policy = LeapDeliveryPolicy::Inline);
+		HEvent connectFrame(std::function<void(const LeapFrame*)> func,
+			LeapDeliveryPolicy policy = LeapDeliveryPolicy::Inline);
+		/** @} */
+
+		/**
+		 * Delivers events queued for subscribers using LeapDeliveryPolicy::MainThread and writes messages logged by the
+		 * message pump thread to the engine log. Must be called from the main thread, CLeapServiceProvider calls it every
+		 * update.
+		 */
+		void dispatchQueuedEvents();
+
+		/** Returns the ring messages of the message pump thread are logged to. */
+		const LeapLogRing& getLogRing() const { return mLog; }
+
+		/** Returns queue overflow and latency statistics of a queued delivery policy. */
+		LeapDispatchStats getDispatchStats(LeapDeliveryPolicy policy) const { return mDispatcher.getStats(policy); }
+
+		/**
+		 * Handles a tracking event as if it was received by the message pump thread, publishing it to the frame history
+		 * and to the subscribers. Lets frames be replayed without a device, must not be called while a connection is
+		 * running. For internal use.
+		 */
+		void _injectTrackingEvent(const LEAP_TRACKING_EVENT* trackingEvent) { handleOnTracking(trackingEvent); }
+
 	public:
+		/** Default maximum number of hands stored per frame in the frame history. */
+		static constexpr UINT32 DEFAULT_MAX_HANDS = 4;
+
+		/** Maximum number of events waiting for delivery, per queued delivery policy. */
+		static constexpr UINT32 EVENT_QUEUE_CAPACITY = 256;
+
+		/** Maximum number of log messages of the message pump thread waiting to be written to the engine log. */
+		static constexpr UINT32 LOG_RING_CAPACITY = 128;
+
 		typedef void(*PfnOnConnection)(const LEAP_CONNECTION_EVENT* connectionEvent);
 		typedef void(*PfnOnConnectionLost)(const LEAP_CONNECTION_LOST_EVENT *connectionLostEvent);
 		typedef void(*PfnOnDevice)(const LEAP_DEVICE_EVENT *deviceEvent);
 		typedef void(*PfnOnDeviceFailure)(const LEAP_DEVICE_FAILURE_EVENT *deviceFailureEvent);
+		typedef void(*PfnOnDeviceStatusChange)(const LEAP_DEVICE_STATUS_CHANGE_EVENT *deviceStatusChangeEvent);
+		typedef void(*PfnOnDroppedFrame)(const LEAP_DROPPED_FRAME_EVENT *droppedFrameEvent);
 		typedef void(*PfnOnPolicy)(const UINT32 currentPolicies);
 		typedef void(*PfnOnTracking)(const LeapFrame *trackingEvent);
 		typedef void(*PfnOnLog)(const eLeapLogSeverity severity, const INT64 timestamp, const char *message);
@@ -134,11 +386,18 @@ namespace bs
 		Event<void(const LEAP_DEVICE_EVENT *deviceEvent)> onDevice;
 		Event<void(const LEAP_DEVICE_EVENT *deviceEvent)> onDeviceLost;
 		Event<void(const LEAP_DEVICE_FAILURE_EVENT *deviceFailureEvent)> onDeviceFailure;
+		Event<void(const LEAP_DEVICE_STATUS_CHANGE_EVENT *deviceStatusChangeEvent)> onDeviceStatusChange;
+		Event<void(const LEAP_DROPPED_FRAME_EVENT *droppedFrameEvent)> onDroppedFrame;
 		Event<void(const UINT32 currentPolicies)> onPolicy;
 		Event<void(const LeapFrame *trackingEvent)> onFrame;
+		/** Triggered on the main thread, from dispatchQueuedEvents(), for every log message sent by the service. */
 		Event<void(const eLeapLogSeverity severity, const INT64 timestamp, const char *message)> onLogMessage;
 		Event<void(const UINT32 requestID, const bool success)> onConfigChange;
 		Event<void(const UINT32 requestID, LEAP_VARIANT value)> onConfigResponse;
+		/**
+		 * Triggered on the message pump thread for every image. Always inline, as LeapC only keeps the image data until
+		 * the next message is polled, right after the subscribers return.
+		 */
 		Event<void(const LEAP_IMAGE_EVENT *imageEvent)> onImage;
 		Event<void(const LEAP_POINT_MAPPING_CHANGE_EVENT *pointMappingChangeEvent)> onPointMappingChange;
 		Event<void(const LEAP_HEAD_POSE_EVENT *headPoseEvent)> onHeadPose;
@@ -152,8 +411,29 @@ namespace bs
 
 		SPtr<LeapDevice> findDeviceByHandle(LeapDeviceHandle handle) const;
 
-		/** Caches the newest frame by copying the tracking event struct returned by LeapC. */
-		void pushFrame(const LeapFrame *frame);
+		/** Opens the connection and starts the message pump thread. Must be called with mConnectionMutex held. */
+		void openConnection();
+
+		/** Closes the connection and stops the message pump thread. Must be called with mConnectionMutex held. */
+		void closeConnection();
+
+		/** Checks the connection with LeapC, called by the connection monitor. */
+		bool checkConnection();
+
+		/** Closes and reopens the connection, called by the connection monitor. */
+		void reconnect(UINT32 attempt);
+
+		/**
+		 * Publishes the connection status from the state of the connection and the attached devices. Must be called from
+		 * the message pump thread, or while it is stopped.
+		 */
+		void updateConnectionStatus();
+
+		/**
+		 * Publishes the newest frame to the history by copying the tracking event struct returned by LeapC. Returns the
+		 * serial of the frame in the history.
+		 */
+		UINT64 pushFrame(const LeapFrame *frame, UINT32 gapBefore);
 
 		void handleOnConnection(const LEAP_CONNECTION_EVENT* connection_event);
 
@@ -165,6 +445,10 @@ namespace bs
 
 		void handleOnDeviceFailure(const LEAP_DEVICE_FAILURE_EVENT *device_failure_event);
 
+		void handleOnDeviceStatusChange(const LEAP_DEVICE_STATUS_CHANGE_EVENT *device_status_change_event);
+
+		void handleOnDroppedFrame(const LEAP_DROPPED_FRAME_EVENT *dropped_frame_event);
+
 		void handleOnTracking(const LEAP_TRACKING_EVENT *tracking_event);
 
 		void handleOnLog(const LEAP_LOG_EVENT *log_event);
@@ -188,28 +472,55 @@ namespace bs
 		bool mIsConnected = false;
 
 		LEAP_ALLOCATOR mAllocator;
+		LeapSlabAllocator mSlabAllocator;
+		AllocatorMode mAllocatorMode = AllocatorMode::Pooled;
 
-		Mutex mMutex;
 		Thread* mThread;
 		volatile bool mIsRunning = false;
 
+		/** Serializes opening and closing the connection between the caller and the connection monitor. */
+		Mutex mConnectionMutex;
+
+		UINT32 mNumSessions = 0;
+		mutable Mutex mSessionMutex;
+		std::atomic<ConnectionStatus> mConnectionStatus{ ConnectionStatus::Disconnected };
+
 		static constexpr INT32 _frameBufferLength = 60;
 
-		CircularBuffer<LeapFrame> mFrames;
+		LeapFrameHistory mFrames;
+		LeapFrameCache mFrameCache;
+
+		LeapClockSync mClockSync;
+		SmoothedFloat mSmoothedTrackingLatency;
+		UINT64 mFrameTime = 0;
+		UINT64 mClockFrameIdx = std::numeric_limits<UINT64>::max();
+		LeapEventDispatcher mDispatcher;
+		LeapTrackingMonitor mMonitor;
+		LeapLogRing mLog;
+
+		/** Number of frames pushed to the history since the module started, across reconnections. */
+		std::atomic<UINT64> mNumFramesPublished{ 0 };
 
+		/** Number of threads blocked in waitForFrame(). The message pump only signals when there are any. */
+		std::atomic<UINT32> mNumFrameWaiters{ 0 };
+		Mutex mFrameWaitMutex;
+		Signal mFrameWaitSignal;
+
+		/** Written by the message pump and by closing the connection, which can happen on the connection monitor thread. */
 		Map<LeapDeviceHandle, SPtr<LeapDevice>> mDevices;
+		mutable Mutex mDevicesMutex;
 
 		//Policy and enabled features
 		UINT64 mRequestedPolicies = 0;
 		UINT64 mActivePolicies = 0;
 
+		/** Declared last, so its thread is stopped before anything it uses is destroyed. */
+		LeapConnectionMonitor mConnectionMonitor;
+
 		/*********************************************************************** */
 		/* 							MODULE OVERRIDES                      		 */
 		/*********************************************************************** */
 	public:
-		/** @copydoc Module::onStartUp */
-		void onStartUp() override;
-
 		/** @copydoc Module::onShutDown */
 		void onShutDown() override;
 	};
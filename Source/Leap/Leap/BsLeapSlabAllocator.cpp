@@ -0,0 +1,123 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapSlabAllocator.h"
+
+namespace bs
+{
+	LeapSlabAllocator::~LeapSlabAllocator()
+	{
+		trim();
+	}
+
+	LEAP_ALLOCATOR LeapSlabAllocator::getLeapAllocator()
+	{
+		LEAP_ALLOCATOR allocator;
+		allocator.allocate = &LeapSlabAllocator::leapAllocate;
+		allocator.deallocate = &LeapSlabAllocator::leapDeallocate;
+		allocator.state = this;
+
+		return allocator;
+	}
+
+	void* LeapSlabAllocator::allocate(UINT32 size)
+	{
+		mNumAllocations.fetch_add(1, std::memory_order_relaxed);
+
+		UINT32 sizeClass = getSizeClass(size);
+		if (sizeClass != UNPOOLED_SIZE_CLASS)
+		{
+			BlockHeader* block = NULL;
+			{
+				ScopedSpinLock lock(mLock);
+
+				block = mFreeLists[sizeClass];
+				if (block != NULL)
+					mFreeLists[sizeClass] = block->mNext;
+			}
+
+			if (block != NULL)
+			{
+				mNumRecycled.fetch_add(1, std::memory_order_relaxed);
+				return block + 1;
+			}
+
+			size = 1U << (MIN_SIZE_CLASS_SHIFT + sizeClass);
+		}
+
+		BlockHeader* block = (BlockHeader*)bs_alloc_aligned16(sizeof(BlockHeader) + size);
+		block->mNext = NULL;
+		block->mSizeClass = sizeClass;
+
+		return block + 1;
+	}
+
+	void LeapSlabAllocator::free(void* ptr)
+	{
+		if (ptr == NULL)
+			return;
+
+		BlockHeader* block = (BlockHeader*)ptr - 1;
+		if (block->mSizeClass == UNPOOLED_SIZE_CLASS)
+		{
+			bs_free_aligned16(block);
+			return;
+		}
+
+		ScopedSpinLock lock(mLock);
+
+		block->mNext = mFreeLists[block->mSizeClass];
+		mFreeLists[block->mSizeClass] = block;
+	}
+
+	void LeapSlabAllocator::trim()
+	{
+		BlockHeader* freeLists[NUM_SIZE_CLASSES];
+		{
+			ScopedSpinLock lock(mLock);
+
+			for (UINT32 i = 0; i < NUM_SIZE_CLASSES; i++)
+			{
+				freeLists[i] = mFreeLists[i];
+				mFreeLists[i] = NULL;
+			}
+		}
+
+		for (UINT32 i = 0; i < NUM_SIZE_CLASSES; i++)
+		{
+			BlockHeader* block = freeLists[i];
+			while (block != NULL)
+			{
+				BlockHeader* next = block->mNext;
+				bs_free_aligned16(block);
+				block = next;
+			}
+		}
+	}
+
+	UINT32 LeapSlabAllocator::getSizeClass(UINT32 size)
+	{
+		UINT32 sizeClass = 0;
+		UINT32 classSize = 1U << MIN_SIZE_CLASS_SHIFT;
+		while (classSize < size)
+		{
+			sizeClass++;
+			if (sizeClass == NUM_SIZE_CLASSES)
+				return UNPOOLED_SIZE_CLASS;
+
+			classSize <<= 1;
+		}
+
+		return sizeClass;
+	}
+
+	void* LeapSlabAllocator::leapAllocate(uint32_t size, eLeapAllocatorType typeHint, void* state)
+	{
+		return static_cast<LeapSlabAllocator*>(state)->allocate(size);
+	}
+
+	void LeapSlabAllocator::leapDeallocate(void* ptr, void* state)
+	{
+		static_cast<LeapSlabAllocator*>(state)->free(ptr);
+	}
+}
\ No newline at end of file
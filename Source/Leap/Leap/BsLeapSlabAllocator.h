@@ -0,0 +1,80 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+#include "Threading/BsSpinLock.h"
+
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	/**
+	 * Pooled allocator installed on a LeapC connection through LEAP_ALLOCATOR.
+	 *
+	 * Requests are rounded up to power of two size classes. Freed blocks are kept on a per-class free list and handed
+	 * out again on the next request of the same class, so once LeapC reaches its steady state (a fixed set of buffer
+	 * sizes per device) the message pump thread no longer hits the heap. Requests larger than the biggest size class go
+	 * straight to the heap.
+	 */
+	class LeapSlabAllocator
+	{
+	public:
+		LeapSlabAllocator() = default;
+		LeapSlabAllocator(const LeapSlabAllocator&) = delete;
+		~LeapSlabAllocator();
+
+		/** Returns a LEAP_ALLOCATOR that routes LeapC allocations to this object. */
+		LEAP_ALLOCATOR getLeapAllocator();
+
+		/** Returns a 16-byte aligned block of at least @p size bytes. */
+		void* allocate(UINT32 size);
+
+		/** Returns a block previously obtained from allocate() to the pool. */
+		void free(void* ptr);
+
+		/** Releases all blocks currently held in the free lists back to the heap. Blocks in use are unaffected. */
+		void trim();
+
+		/** Returns the total number of allocate() calls. */
+		UINT64 getNumAllocations() const { return mNumAllocations.load(std::memory_order_relaxed); }
+
+		/** Returns the number of allocate() calls that were served from a free list instead of the heap. */
+		UINT64 getNumRecycled() const { return mNumRecycled.load(std::memory_order_relaxed); }
+
+	private:
+		/** Header stored in front of every block. Padded so the user pointer keeps 16-byte alignment. */
+		struct alignas(16) BlockHeader
+		{
+			BlockHeader* mNext;
+			UINT32 mSizeClass;
+		};
+
+		/** Size of the smallest size class is 1 << MIN_SIZE_CLASS_SHIFT bytes. */
+		static constexpr UINT32 MIN_SIZE_CLASS_SHIFT = 8;
+
+		/** Number of pooled size classes, the biggest one being 1 << (MIN_SIZE_CLASS_SHIFT + NUM_SIZE_CLASSES - 1). */
+		static constexpr UINT32 NUM_SIZE_CLASSES = 16;
+
+		/** Size class assigned to blocks that are too big to be pooled. */
+		static constexpr UINT32 UNPOOLED_SIZE_CLASS = NUM_SIZE_CLASSES;
+
+		/** Returns the size class able to fit @p size bytes, or UNPOOLED_SIZE_CLASS if it doesn't fit any. */
+		static UINT32 getSizeClass(UINT32 size);
+
+		static void* leapAllocate(uint32_t size, eLeapAllocatorType typeHint, void* state);
+		static void leapDeallocate(void* ptr, void* state);
+
+		BlockHeader* mFreeLists[NUM_SIZE_CLASSES] = { };
+		SpinLock mLock;
+
+		std::atomic<UINT64> mNumAllocations{ 0 };
+		std::atomic<UINT64> mNumRecycled{ 0 };
+	};
+
+	/** @} */
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapTimingHistogram.h"
+#include "Math/BsBitwise.h"
+
+namespace bs
+{
+	void LeapTimingHistogram::record(UINT64 duration)
+	{
+		mBuckets[getBucket(duration)].fetch_add(1, std::memory_order_relaxed);
+		mTotal.fetch_add(duration, std::memory_order_relaxed);
+
+		UINT64 max = mMax.load(std::memory_order_relaxed);
+		while (duration > max && !mMax.compare_exchange_weak(max, duration, std::memory_order_relaxed))
+		{ }
+	}
+
+	LeapTimingStats LeapTimingHistogram::getStats() const
+	{
+		// Counted from the same snapshot the percentiles are computed from, so they always agree
+		UINT64 counts[NUM_BUCKETS];
+		UINT64 numSamples = 0;
+		for (UINT32 i = 0; i < NUM_BUCKETS; ++i)
+		{
+			counts[i] = mBuckets[i].load(std::memory_order_relaxed);
+			numSamples += counts[i];
+		}
+
+		LeapTimingStats output;
+		output.mNumSamples = numSamples;
+		output.mTotal = mTotal.load(std::memory_order_relaxed);
+		output.mMax = mMax.load(std::memory_order_relaxed);
+
+		if (numSamples == 0)
+			return output;
+
+		// Ranks of the samples at the percentiles, rounding up so that p99 of a few samples is their maximum
+		UINT64 p50Rank = (numSamples * 50 + 99) / 100;
+		UINT64 p99Rank = (numSamples * 99 + 99) / 100;
+
+		UINT64 seen = 0;
+		bool foundP50 = false;
+		for (UINT32 i = 0; i < NUM_BUCKETS; ++i)
+		{
+			seen += counts[i];
+
+			if (!foundP50 && seen >= p50Rank)
+			{
+				output.mP50 = getBucketUpperBound(i);
+				foundP50 = true;
+			}
+
+			if (seen >= p99Rank)
+			{
+				output.mP99 = getBucketUpperBound(i);
+				break;
+			}
+		}
+
+		// The bucket bounds overestimate, the maximum is known exactly
+		output.mP50 = std::min(output.mP50, output.mMax);
+		output.mP99 = std::min(output.mP99, output.mMax);
+
+		return output;
+	}
+
+	void LeapTimingHistogram::reset()
+	{
+		for (auto& entry : mBuckets)
+			entry.store(0, std::memory_order_relaxed);
+
+		mTotal.store(0, std::memory_order_relaxed);
+		mMax.store(0, std::memory_order_relaxed);
+	}
+
+	UINT32 LeapTimingHistogram::getBucket(UINT64 duration)
+	{
+		if (duration < NUM_LINEAR_BUCKETS)
+			return (UINT32)duration;
+
+		if (duration > 0xFFFFFFFF)
+			return NUM_BUCKETS - 1;
+
+		// The two bits following the leading one pick the sub-bucket
+		UINT32 exponent = Bitwise::mostSignificantBit((UINT32)duration);
+		UINT32 subBucket = (UINT32)(duration >> (exponent - 2)) & (NUM_SUB_BUCKETS - 1);
+
+		return NUM_LINEAR_BUCKETS + (exponent - 4) * NUM_SUB_BUCKETS + subBucket;
+	}
+
+	UINT64 LeapTimingHistogram::getBucketUpperBound(UINT32 bucket)
+	{
+		if (bucket < NUM_LINEAR_BUCKETS)
+			return bucket;
+
+		UINT32 exponent = 4 + (bucket - NUM_LINEAR_BUCKETS) / NUM_SUB_BUCKETS;
+		UINT32 subBucket = (bucket - NUM_LINEAR_BUCKETS) % NUM_SUB_BUCKETS;
+
+		UINT64 lowerBound = ((UINT64)(NUM_SUB_BUCKETS + subBucket)) << (exponent - 2);
+		return lowerBound + (1ULL << (exponent - 2)) - 1;
+	}
+}
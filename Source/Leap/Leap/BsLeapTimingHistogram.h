@@ -0,0 +1,113 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+#include "Profiling/BsProfilerCPU.h"
+#include "Utility/BsTime.h"
+
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	/** Summary of the durations recorded by a LeapTimingHistogram. All durations are in microseconds. */
+	struct LeapTimingStats
+	{
+		/** Number of recorded durations. */
+		UINT64 mNumSamples = 0;
+		/** Sum of the recorded durations. */
+		UINT64 mTotal = 0;
+		/** Median duration, rounded up to the bucket it falls in. */
+		UINT64 mP50 = 0;
+		/** 99th percentile duration, rounded up to the bucket it falls in. */
+		UINT64 mP99 = 0;
+		/** Longest duration. Exact. */
+		UINT64 mMax = 0;
+
+		/** Returns the average duration. */
+		float getAverage() const { return mNumSamples > 0 ? (float)mTotal / mNumSamples : 0.0f; }
+	};
+
+	/**
+	 * Histogram of durations over fixed, logarithmically spaced buckets. Durations under 16 microseconds get a bucket
+	 * each, longer ones fall in one of four buckets per power of two, which bounds the error of the percentiles to 25%.
+	 *
+	 * Recording only increments atomic counters, so it never blocks or allocates and any thread can record while another
+	 * one reads the statistics.
+	 */
+	class LeapTimingHistogram
+	{
+	public:
+		LeapTimingHistogram() = default;
+		LeapTimingHistogram(const LeapTimingHistogram&) = delete;
+
+		/** Records a duration, in microseconds. */
+		void record(UINT64 duration);
+
+		/** Returns the statistics of the durations recorded so far. */
+		LeapTimingStats getStats() const;
+
+		/** Forgets every recorded duration. Durations recorded concurrently may be partially kept. */
+		void reset();
+
+	public:
+		/** Durations with a bucket each. */
+		static constexpr UINT32 NUM_LINEAR_BUCKETS = 16;
+
+		/** Buckets per power of two, past the linear buckets. */
+		static constexpr UINT32 NUM_SUB_BUCKETS = 4;
+
+		/** Total number of buckets, covering durations up to 2^32 microseconds. Longer ones go to the last bucket. */
+		static constexpr UINT32 NUM_BUCKETS = NUM_LINEAR_BUCKETS + (32 - 4) * NUM_SUB_BUCKETS;
+
+	private:
+		/** Returns the bucket @p duration falls in. */
+		static UINT32 getBucket(UINT64 duration);
+
+		/** Returns the longest duration falling in @p bucket. */
+		static UINT64 getBucketUpperBound(UINT32 bucket);
+
+		std::atomic<UINT64> mBuckets[NUM_BUCKETS] = { };
+		std::atomic<UINT64> mTotal{ 0 };
+		std::atomic<UINT64> mMax{ 0 };
+	};
+
+	/**
+	 * Records the time spent in a scope in a LeapTimingHistogram, and reports it as a ProfilerCPU sample under the same
+	 * name.
+	 */
+	class LeapScopedTiming
+	{
+	public:
+		/**
+		 * Starts timing.
+		 *
+		 * @param histogram	Receives the duration of the scope.
+		 * @param name		Name of the profiler sample. Must outlive the scope.
+		 */
+		LeapScopedTiming(LeapTimingHistogram& histogram, const char* name)
+			: mHistogram(histogram), mName(name), mStart(gTime().getTimePrecise())
+		{
+			gProfilerCPU().beginSample(mName);
+		}
+
+		LeapScopedTiming(const LeapScopedTiming&) = delete;
+
+		~LeapScopedTiming()
+		{
+			gProfilerCPU().endSample(mName);
+			mHistogram.record(gTime().getTimePrecise() - mStart);
+		}
+
+	private:
+		LeapTimingHistogram& mHistogram;
+		const char* mName;
+		UINT64 mStart;
+	};
+
+	/** @} */
+}
@@ -0,0 +1,81 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "Leap/BsLeapTrackingMonitor.h"
+
+namespace bs
+{
+	UINT32 LeapTrackingMonitor::recordFrame(INT64 trackingFrameId)
+	{
+		INT64 lastTrackingFrameId = mLastTrackingFrameId;
+		mLastTrackingFrameId = trackingFrameId;
+
+		// Ids going backwards mean the service restarted its sequence, which isn't a gap
+		if (lastTrackingFrameId < 0 || trackingFrameId <= lastTrackingFrameId + 1)
+			return 0;
+
+		UINT64 gap = (UINT64)(trackingFrameId - lastTrackingFrameId - 1);
+		mNumFrameGaps.fetch_add(1, std::memory_order_relaxed);
+		mNumSkippedFrames.fetch_add(gap, std::memory_order_relaxed);
+
+		// Single writer, so nobody else can raise the maximum in between
+		if (gap > mMaxFrameGap.load(std::memory_order_relaxed))
+			mMaxFrameGap.store(gap, std::memory_order_relaxed);
+
+		return (UINT32)std::min(gap, (UINT64)std::numeric_limits<UINT32>::max());
+	}
+
+	void LeapTrackingMonitor::recordDroppedFrame(eLeapDroppedFrameType type)
+	{
+		UINT32 index = std::min((UINT32)type, (UINT32)eLeapDroppedFrameType_Other);
+		mNumDroppedFrames[index].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void LeapTrackingMonitor::recordStatusChange(UINT32 lastStatus, UINT32 status)
+	{
+		mNumStatusChanges.fetch_add(1, std::memory_order_relaxed);
+		mDeviceStatus.store(status, std::memory_order_relaxed);
+
+		// Failure codes aren't flag combinations, they are reported through device failure events instead
+		if ((status & eLeapDeviceStatus_UnknownFailure) == eLeapDeviceStatus_UnknownFailure)
+			return;
+
+		if ((lastStatus & eLeapDeviceStatus_UnknownFailure) == eLeapDeviceStatus_UnknownFailure)
+			lastStatus = 0;
+
+		UINT32 changed = lastStatus ^ status;
+		for (UINT32 i = 0; i < LeapTrackingMetrics::NUM_STATUS_FLAGS; i++)
+		{
+			UINT32 flag = 1U << i;
+			if ((changed & flag) == 0)
+				continue;
+
+			if (status & flag)
+				mNumStatusRaised[i].fetch_add(1, std::memory_order_relaxed);
+			else
+				mNumStatusCleared[i].fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	LeapTrackingMetrics LeapTrackingMonitor::getMetrics() const
+	{
+		LeapTrackingMetrics metrics;
+		for (UINT32 i = 0; i <= eLeapDroppedFrameType_Other; i++)
+			metrics.mNumDroppedFrames[i] = mNumDroppedFrames[i].load(std::memory_order_relaxed);
+
+		metrics.mNumFrameGaps = mNumFrameGaps.load(std::memory_order_relaxed);
+		metrics.mNumSkippedFrames = mNumSkippedFrames.load(std::memory_order_relaxed);
+		metrics.mMaxFrameGap = mMaxFrameGap.load(std::memory_order_relaxed);
+		metrics.mNumStatusChanges = mNumStatusChanges.load(std::memory_order_relaxed);
+
+		for (UINT32 i = 0; i < LeapTrackingMetrics::NUM_STATUS_FLAGS; i++)
+		{
+			metrics.mNumStatusRaised[i] = mNumStatusRaised[i].load(std::memory_order_relaxed);
+			metrics.mNumStatusCleared[i] = mNumStatusCleared[i].load(std::memory_order_relaxed);
+		}
+
+		metrics.mDeviceStatus = mDeviceStatus.load(std::memory_order_relaxed);
+
+		return metrics;
+	}
+}
\ No newline at end of file
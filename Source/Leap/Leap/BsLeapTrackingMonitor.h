@@ -0,0 +1,87 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup Leap
+	 *  @{
+	 */
+
+	/** Snapshot of the counters kept by LeapTrackingMonitor. */
+	struct LeapTrackingMetrics
+	{
+		/** Number of device status flags tracked, one per bit from eLeapDeviceStatus_Streaming to _LowResource. */
+		static constexpr UINT32 NUM_STATUS_FLAGS = 5;
+
+		/** Number of frames the service reported as dropped, indexed by eLeapDroppedFrameType. */
+		UINT64 mNumDroppedFrames[eLeapDroppedFrameType_Other + 1] = { };
+
+		/** Number of times the tracking frame id skipped values between two received frames. */
+		UINT64 mNumFrameGaps = 0;
+
+		/** Total number of tracking frame ids skipped over all gaps. */
+		UINT64 mNumSkippedFrames = 0;
+
+		/** Longest run of skipped tracking frame ids. */
+		UINT64 mMaxFrameGap = 0;
+
+		/** Number of device status change events received. */
+		UINT64 mNumStatusChanges = 0;
+
+		/** Number of times each status flag was raised, indexed by bit position. */
+		UINT64 mNumStatusRaised[NUM_STATUS_FLAGS] = { };
+
+		/** Number of times each status flag was cleared, indexed by bit position. */
+		UINT64 mNumStatusCleared[NUM_STATUS_FLAGS] = { };
+
+		/** Most recent combination of eLeapDeviceStatus flags reported by a device. */
+		UINT32 mDeviceStatus = 0;
+	};
+
+	/**
+	 * Keeps counters about dropped frames and device health, which tell whether the application consumes frames too
+	 * slowly or the device is degraded. Written by the LeapC message pump thread and readable from any thread.
+	 */
+	class LeapTrackingMonitor
+	{
+	public:
+		/**
+		 * Records the reception of a tracking frame.
+		 *
+		 * @param trackingFrameId	The tracking frame id of the received frame.
+		 * @returns					The number of tracking frame ids skipped since the previous frame.
+		 */
+		UINT32 recordFrame(INT64 trackingFrameId);
+
+		/** Records a LEAP_DROPPED_FRAME_EVENT. */
+		void recordDroppedFrame(eLeapDroppedFrameType type);
+
+		/** Records a LEAP_DEVICE_STATUS_CHANGE_EVENT. */
+		void recordStatusChange(UINT32 lastStatus, UINT32 status);
+
+		/** Forgets the last received frame, so the next one doesn't count as a gap. Used when the connection restarts. */
+		void resetFrameSequence() { mLastTrackingFrameId = -1; }
+
+		/** Returns a copy of the current counters. */
+		LeapTrackingMetrics getMetrics() const;
+
+	private:
+		INT64 mLastTrackingFrameId = -1;
+
+		std::atomic<UINT64> mNumDroppedFrames[eLeapDroppedFrameType_Other + 1] = { };
+		std::atomic<UINT64> mNumFrameGaps{ 0 };
+		std::atomic<UINT64> mNumSkippedFrames{ 0 };
+		std::atomic<UINT64> mMaxFrameGap{ 0 };
+		std::atomic<UINT64> mNumStatusChanges{ 0 };
+		std::atomic<UINT64> mNumStatusRaised[LeapTrackingMetrics::NUM_STATUS_FLAGS] = { };
+		std::atomic<UINT64> mNumStatusCleared[LeapTrackingMetrics::NUM_STATUS_FLAGS] = { };
+		std::atomic<UINT32> mDeviceStatus{ 0 };
+	};
+
+	/** @} */
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+
+#include <atomic>
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/**
+	 * A fixed capacity FIFO queue for exactly one producer thread and one consumer thread. Neither side ever blocks or
+	 * allocates: pushing to a full queue fails and popping from an empty one fails.
+	 *
+	 * Object types used must have default parameterless constructor and be copy assignable.
+	 */
+	template<typename T, typename A = StdAlloc<T>>
+	class BoundedQueue
+	{
+	public:
+		/** The first template parameter (T) */
+		typedef T value_type;
+		/** The second template parameter (A) */
+		typedef A allocator_type;
+		/** const value_type& */
+		typedef const value_type& const_reference;
+
+	public:
+		/** Construct BoundedQueue. Capacity is rounded up to a power of two. */
+		BoundedQueue(UINT32 capacity)
+		{
+			mCapacity = 1;
+			while (mCapacity < capacity)
+				mCapacity <<= 1;
+
+			mMask = mCapacity - 1;
+			mArray.resize(mCapacity);
+		}
+
+		/** Return size of allocated storage capacity. */
+		UINT32 capacity() const { return mCapacity; }
+
+		/** Returns the number of elements in the queue. Only exact when called from the producer or consumer. */
+		UINT32 size() const
+		{
+			UINT64 tail = mTail.load(std::memory_order_acquire);
+			UINT64 head = mHead.load(std::memory_order_acquire);
+			return (UINT32)(tail - head);
+		}
+
+		/** Test whether container is empty. Only exact when called from the producer or consumer. */
+		bool empty() const { return size() == 0; }
+
+		/** Adds an element to the back of the queue. Returns false if the queue is full. Producer thread only. */
+		bool tryPush(const_reference val)
+		{
+			UINT64 tail = mTail.load(std::memory_order_relaxed);
+			if (tail - mHead.load(std::memory_order_acquire) >= mCapacity)
+				return false;
+
+			mArray[tail & mMask] = val;
+			mTail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/** Removes the element at the front of the queue. Returns false if the queue is empty. Consumer thread only. */
+		bool tryPop(value_type& val)
+		{
+			UINT64 head = mHead.load(std::memory_order_relaxed);
+			if (head == mTail.load(std::memory_order_acquire))
+				return false;
+
+			val = mArray[head & mMask];
+			mHead.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+	private:
+		UINT32 mCapacity;
+		UINT32 mMask;
+
+		Vector<value_type, A> mArray;
+
+		std::atomic<UINT64> mHead{ 0 };
+		std::atomic<UINT64> mTail{ 0 };
+	};
+
+	/** @} */
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "BsLeapTestSuite.h"
+#include "Utility/BsBoundedQueue.h"
+
+#include <thread>
+
+using namespace bs;
+
+BoundedQueueTestSuite::BoundedQueueTestSuite()
+{
+	BS_ADD_TEST(BoundedQueueTestSuite::boundedQueueRoundsCapacity)
+	BS_ADD_TEST(BoundedQueueTestSuite::boundedQueueFullAndEmpty)
+	BS_ADD_TEST(BoundedQueueTestSuite::boundedQueueWrapsAround)
+	BS_ADD_TEST(BoundedQueueTestSuite::boundedQueueAcrossThreads)
+}
+
+void BoundedQueueTestSuite::boundedQueueRoundsCapacity()
+{
+	BS_TEST_ASSERT(BoundedQueue<UINT32>(1).capacity() == 1);
+	BS_TEST_ASSERT(BoundedQueue<UINT32>(4).capacity() == 4);
+	BS_TEST_ASSERT(BoundedQueue<UINT32>(5).capacity() == 8);
+}
+
+void BoundedQueueTestSuite::boundedQueueFullAndEmpty()
+{
+	BoundedQueue<UINT32> queue(4);
+
+	UINT32 value = 0;
+	BS_TEST_ASSERT(queue.empty());
+	BS_TEST_ASSERT(!queue.tryPop(value));
+
+	for (UINT32 i = 0; i < 4; i++)
+		BS_TEST_ASSERT(queue.tryPush(i));
+
+	// A full queue rejects the element and keeps the others
+	BS_TEST_ASSERT(queue.size() == 4);
+	BS_TEST_ASSERT(!queue.tryPush(4));
+	BS_TEST_ASSERT(queue.size() == 4);
+
+	for (UINT32 i = 0; i < 4; i++)
+		BS_TEST_ASSERT(queue.tryPop(value) && value == i);
+
+	BS_TEST_ASSERT(queue.empty());
+	BS_TEST_ASSERT(!queue.tryPop(value));
+	BS_TEST_ASSERT(value == 3);
+}
+
+void BoundedQueueTestSuite::boundedQueueWrapsAround()
+{
+	BoundedQueue<UINT32> queue(4);
+
+	// Keeps three elements in flight, so every slot is reused many times at every offset
+	UINT32 numPushed = 0;
+	UINT32 numPopped = 0;
+	bool inOrder = true;
+	while (numPushed < 1000)
+	{
+		while (queue.size() < 3)
+			queue.tryPush(numPushed++);
+
+		UINT32 value;
+		inOrder &= queue.tryPop(value) && value == numPopped++;
+	}
+
+	UINT32 value;
+	while (queue.tryPop(value))
+		inOrder &= value == numPopped++;
+
+	BS_TEST_ASSERT(inOrder);
+	BS_TEST_ASSERT(numPopped == numPushed);
+}
+
+void BoundedQueueTestSuite::boundedQueueAcrossThreads()
+{
+	constexpr UINT32 NUM_VALUES = 100000;
+
+	// Small, so both sides keep hitting a full and an empty queue
+	BoundedQueue<UINT32> queue(8);
+
+	Thread producer([&queue]()
+	{
+		for (UINT32 i = 0; i < NUM_VALUES; )
+		{
+			if (queue.tryPush(i))
+				i++;
+			else
+				std::this_thread::yield();
+		}
+	});
+
+	UINT32 numPopped = 0;
+	bool inOrder = true;
+	while (numPopped < NUM_VALUES)
+	{
+		UINT32 value;
+		if (queue.tryPop(value))
+			inOrder &= value == numPopped++;
+		else
+			std::this_thread::yield();
+	}
+
+	producer.join();
+
+	BS_TEST_ASSERT(inOrder);
+	BS_TEST_ASSERT(queue.empty());
+}
@@ -0,0 +1,99 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "BsLeapTestSuite.h"
+#include "Leap/BsLeapFrameAlloc.h"
+#include "Leap/BsLeapFrameHistory.h"
+
+using namespace bs;
+
+LeapFrameAllocTestSuite::LeapFrameAllocTestSuite()
+{
+	BS_ADD_TEST(LeapFrameAllocTestSuite::frameAllocCopiesIntoOwnBuffer)
+	BS_ADD_TEST(LeapFrameAllocTestSuite::frameAllocReusesBufferAcrossFrames)
+	BS_ADD_TEST(LeapFrameAllocTestSuite::frameAllocReusesBufferAcrossHistoryReads)
+}
+
+void LeapFrameAllocTestSuite::frameAllocCopiesIntoOwnBuffer()
+{
+	LeapHand hands[2];
+	LeapFrame frame;
+	makeFrame(frame, hands, 2, 1);
+
+	LeapFrameAlloc alloc;
+	BS_TEST_ASSERT(alloc.get() == NULL);
+
+	alloc.copyFrom(reinterpret_cast<const LEAP_TRACKING_EVENT*>(&frame));
+	BS_TEST_ASSERT(alloc.get() != NULL);
+	BS_TEST_ASSERT(alloc.size() == alloc._sizeBytesNumberOfHands(2));
+	BS_TEST_ASSERT(alloc.get()->mHands == reinterpret_cast<const LeapHand*>(alloc.get() + 1));
+	BS_TEST_ASSERT(alloc.get()->mHands[1].mId == 11);
+
+	// Copies point to their own hands, not to those of the frame they were copied from
+	LeapFrameAlloc copy;
+	copy = alloc;
+	BS_TEST_ASSERT(copy.get() != alloc.get());
+	BS_TEST_ASSERT(copy.get()->mHands == reinterpret_cast<const LeapHand*>(copy.get() + 1));
+	BS_TEST_ASSERT(copy.get()->mHands[1].mId == 11);
+
+	LeapFrameAlloc empty;
+	copy = empty;
+	BS_TEST_ASSERT(copy.get() == NULL);
+}
+
+void LeapFrameAllocTestSuite::frameAllocReusesBufferAcrossFrames()
+{
+	LeapFrameAlloc alloc;
+	alloc.reserveNumberOfHands(4);
+	BS_TEST_ASSERT(alloc.size() == 0);
+
+	LeapHand hands[4];
+	LeapFrame frame;
+
+	makeFrame(frame, hands, 4, 1);
+	alloc.copyFrom(reinterpret_cast<const LEAP_TRACKING_EVENT*>(&frame));
+	const LeapFrame* buffer = alloc.get();
+
+	// Smaller and then larger frames, up to the reserved size, all go to the same buffer
+	for (UINT32 numHands : { 0U, 1U, 4U, 2U })
+	{
+		makeFrame(frame, hands, numHands, numHands);
+		alloc.copyFrom(reinterpret_cast<const LEAP_TRACKING_EVENT*>(&frame));
+
+		BS_TEST_ASSERT(alloc.get() == buffer);
+		BS_TEST_ASSERT(alloc.get()->mNumberOfHands == numHands);
+		BS_TEST_ASSERT(alloc.size() == alloc._sizeBytesNumberOfHands(numHands));
+	}
+
+	// Shrinking never releases the buffer either
+	alloc.resizeNumberOfHands(1);
+	alloc.reserveNumberOfHands(2);
+	BS_TEST_ASSERT(alloc.get() == buffer);
+}
+
+void LeapFrameAllocTestSuite::frameAllocReusesBufferAcrossHistoryReads()
+{
+	LeapFrameHistory history(4, 2);
+
+	LeapFrameAlloc alloc;
+	alloc.reserveNumberOfHands(history.getMaxHands());
+
+	LeapHand hands[2];
+	LeapFrame frame;
+	makeFrame(frame, hands, 2, 0);
+	history.push(frame);
+
+	BS_TEST_ASSERT(history.read(0, alloc));
+	const LeapFrame* buffer = alloc.get();
+
+	for (INT64 id = 1; id < 8; id++)
+	{
+		makeFrame(frame, hands, (UINT32)(id % 3), id);
+		history.push(frame);
+
+		BS_TEST_ASSERT(history.read(0, alloc));
+		BS_TEST_ASSERT(alloc.get() == buffer);
+		BS_TEST_ASSERT(alloc.get()->mInfo.frame_id == id);
+		BS_TEST_ASSERT(alloc.get()->mNumberOfHands == std::min((UINT32)(id % 3), 2U));
+	}
+}
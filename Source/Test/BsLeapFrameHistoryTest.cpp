@@ -0,0 +1,110 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "BsLeapTestSuite.h"
+#include "Leap/BsLeapFrameHistory.h"
+
+using namespace bs;
+
+LeapFrameHistoryTestSuite::LeapFrameHistoryTestSuite()
+{
+	BS_ADD_TEST(LeapFrameHistoryTestSuite::frameHistoryOwnsHands)
+	BS_ADD_TEST(LeapFrameHistoryTestSuite::frameHistoryDropsHandsPastMaximum)
+	BS_ADD_TEST(LeapFrameHistoryTestSuite::frameHistoryReadAfterWrap)
+	BS_ADD_TEST(LeapFrameHistoryTestSuite::frameHistoryBracketsTimestamps)
+}
+
+void LeapFrameHistoryTestSuite::frameHistoryOwnsHands()
+{
+	LeapFrameHistory history(4, 2);
+
+	LeapHand hands[2];
+	LeapFrame frame;
+	makeFrame(frame, hands, 2, 1);
+	history.push(frame);
+
+	// LeapC reuses its message memory once the event is handled
+	std::memset(hands, 0xFF, sizeof(hands));
+
+	LeapFrameAlloc copy;
+	BS_TEST_ASSERT(history.read(0, copy));
+	BS_TEST_ASSERT(copy.get()->mNumberOfHands == 2);
+	BS_TEST_ASSERT(copy.get()->mHands != hands);
+	BS_TEST_ASSERT(copy.get()->mHands[0].mId == 10);
+	BS_TEST_ASSERT(copy.get()->mHands[1].mId == 11);
+	BS_TEST_ASSERT(copy.get()->mHands[1].mPalm.mPosition == Vector3(1.0f, 1.0f, 0.0f));
+}
+
+void LeapFrameHistoryTestSuite::frameHistoryDropsHandsPastMaximum()
+{
+	LeapFrameHistory history(4, 2);
+
+	LeapHand hands[3];
+	LeapFrame frame;
+	makeFrame(frame, hands, 3, 1);
+	history.push(frame);
+
+	LeapFrameAlloc copy;
+	BS_TEST_ASSERT(history.read(0, copy));
+	BS_TEST_ASSERT(copy.get()->mNumberOfHands == 2);
+	BS_TEST_ASSERT(copy.get()->mHands[1].mId == 11);
+}
+
+void LeapFrameHistoryTestSuite::frameHistoryReadAfterWrap()
+{
+	LeapFrameHistory history(4, 1);
+
+	LeapHand hand;
+	LeapFrame frame;
+	for (INT64 id = 0; id < 10; id++)
+	{
+		makeFrame(frame, &hand, 1, id);
+		BS_TEST_ASSERT(history.push(frame) == (UINT64)id);
+	}
+
+	BS_TEST_ASSERT(history.size() == 4);
+
+	LeapFrameAlloc copy;
+	BS_TEST_ASSERT(history.read(0, copy) && copy.get()->mInfo.frame_id == 9);
+	BS_TEST_ASSERT(copy.get()->mHands[0].mId == 90);
+	BS_TEST_ASSERT(history.read(3, copy) && copy.get()->mInfo.frame_id == 6);
+	BS_TEST_ASSERT(copy.get()->mHands[0].mId == 60);
+	BS_TEST_ASSERT(!history.read(4, copy));
+
+	BS_TEST_ASSERT(history.readSerial(7, copy) && copy.get()->mInfo.frame_id == 7);
+	BS_TEST_ASSERT(!history.readSerial(5, copy));
+	BS_TEST_ASSERT(!history.readSerial(10, copy));
+
+	BS_TEST_ASSERT(history.readTimestamp(1) == 800);
+	BS_TEST_ASSERT(history.readTimestamp(4) == 0);
+	BS_TEST_ASSERT(history.getReadRetryCount() == 0);
+}
+
+void LeapFrameHistoryTestSuite::frameHistoryBracketsTimestamps()
+{
+	LeapFrameHistory history(4, 1);
+
+	LeapHand hand;
+	LeapFrame frame;
+	for (INT64 id = 0; id < 10; id++)
+	{
+		makeFrame(frame, &hand, 1, id);
+		history.push(frame);
+	}
+
+	LeapFrameAlloc before;
+	LeapFrameAlloc after;
+	BS_TEST_ASSERT(history.readBracket(750, before, after));
+	BS_TEST_ASSERT(before.get()->mInfo.frame_id == 7 && after.get()->mInfo.frame_id == 8);
+
+	// A time matching a frame starts the bracket at that frame, unless it's the newest one which nothing follows
+	BS_TEST_ASSERT(history.readBracket(700, before, after));
+	BS_TEST_ASSERT(before.get()->mInfo.frame_id == 7 && after.get()->mInfo.frame_id == 8);
+
+	BS_TEST_ASSERT(history.readBracket(900, before, after));
+	BS_TEST_ASSERT(before.get()->mInfo.frame_id == 8 && after.get()->mInfo.frame_id == 9);
+
+	// Frames overwritten by the wrap can't bracket anything anymore
+	BS_TEST_ASSERT(!history.readBracket(550, before, after));
+	BS_TEST_ASSERT(!history.readBracket(950, before, after));
+}
@@ -0,0 +1,202 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "BsLeapTestSuite.h"
+#include "Leap/BsLeapFrameUtility.h"
+#include "Math/BsMatrix4.h"
+#include "Scene/BsTransform.h"
+
+using namespace bs;
+
+namespace
+{
+	/** More hands than a single transform batch holds, so the remainder of a batch is covered too. */
+	constexpr UINT32 NUM_HANDS = 5;
+
+	/** Largest difference accepted between the batched and the scalar results. */
+	constexpr float TOLERANCE = 1e-4f;
+
+	/** Returns a quaternion built from the given components, normalized. */
+	Quaternion makeRotation(float x, float y, float z, float w)
+	{
+		Quaternion rotation;
+		rotation.x = x;
+		rotation.y = y;
+		rotation.z = z;
+		rotation.w = w;
+		rotation.normalize();
+
+		return rotation;
+	}
+
+	/** Fills @p hands with distinct, deterministic values. */
+	void makeHands(LeapHand* hands, UINT32 numHands)
+	{
+		float value = 1.0f;
+		auto next = [&value]()
+		{
+			value = std::fmod(value * 7.31f + 0.37f, 200.0f);
+			return value - 100.0f;
+		};
+
+		auto nextPosition = [&]() { return Vector3(next(), next(), next()); };
+		auto nextDirection = [&]() { return Vector3::normalize(nextPosition()); };
+		auto nextRotation = [&]() { return makeRotation(next(), next(), next(), next()); };
+
+		for (UINT32 i = 0; i < numHands; i++)
+		{
+			LeapHand& hand = hands[i];
+			std::memset(&hand, 0, sizeof(hand));
+			hand.mId = i;
+
+			hand.mPalm.mPosition = nextPosition();
+			hand.mPalm.mStabilizedPosition = nextPosition();
+			hand.mPalm.mVelocity = nextPosition();
+			hand.mPalm.mNormal = nextDirection();
+			hand.mPalm.mDirection = nextDirection();
+			hand.mPalm.mOrientation = nextRotation();
+
+			auto makeBone = [&](LeapBone& bone)
+			{
+				bone.mPrevJoint = nextPosition();
+				bone.mNextJoint = nextPosition();
+				bone.mRotation = nextRotation();
+			};
+
+			for (auto& digit : hand.mDigits)
+			{
+				for (auto& bone : digit.mBones)
+					makeBone(bone);
+			}
+
+			makeBone(hand.mArm);
+		}
+	}
+
+	bool isNear(const Vector3& a, const Vector3& b)
+	{
+		float scale = std::max(1.0f, std::max(a.length(), b.length()));
+		return (a - b).length() <= TOLERANCE * scale;
+	}
+
+	bool isNear(const Quaternion& a, const Quaternion& b)
+	{
+		return std::abs(a.x - b.x) <= TOLERANCE && std::abs(a.y - b.y) <= TOLERANCE &&
+			std::abs(a.z - b.z) <= TOLERANCE && std::abs(a.w - b.w) <= TOLERANCE;
+	}
+
+	/** Transforms @p hand one member at a time, the way the batched kernel is expected to. */
+	void transformScalar(LeapHand& hand, const Transform& transform)
+	{
+		Matrix4 matrix = transform.getMatrix();
+		const Quaternion& rotation = transform.getRotation();
+
+		LeapPalm& palm = hand.mPalm;
+		palm.mPosition = matrix.multiplyAffine(palm.mPosition);
+		palm.mStabilizedPosition = matrix.multiplyAffine(palm.mStabilizedPosition);
+		palm.mVelocity = matrix.multiplyDirection(palm.mVelocity);
+		// Normals go through the inverse transpose to stay perpendicular to the palm, which for a matrix built from a
+		// rotation and a scale is the rotation applied after the inverse scale
+		palm.mNormal = Vector3::normalize(rotation.rotate(palm.mNormal / transform.getScale()));
+		palm.mDirection = Vector3::normalize(matrix.multiplyDirection(palm.mDirection));
+		palm.mOrientation = rotation * palm.mOrientation;
+
+		auto transformBone = [&](LeapBone& bone)
+		{
+			bone.mPrevJoint = matrix.multiplyAffine(bone.mPrevJoint);
+			bone.mNextJoint = matrix.multiplyAffine(bone.mNextJoint);
+			bone.mRotation = rotation * bone.mRotation;
+		};
+
+		for (auto& digit : hand.mDigits)
+		{
+			for (auto& bone : digit.mBones)
+				transformBone(bone);
+		}
+
+		transformBone(hand.mArm);
+	}
+
+	/** Returns true if every transformed member of @p a matches the one of @p b. */
+	bool isNear(const LeapHand& a, const LeapHand& b)
+	{
+		bool near = isNear(a.mPalm.mPosition, b.mPalm.mPosition) &&
+			isNear(a.mPalm.mStabilizedPosition, b.mPalm.mStabilizedPosition) &&
+			isNear(a.mPalm.mVelocity, b.mPalm.mVelocity) &&
+			isNear(a.mPalm.mNormal, b.mPalm.mNormal) &&
+			isNear(a.mPalm.mDirection, b.mPalm.mDirection) &&
+			isNear(a.mPalm.mOrientation, b.mPalm.mOrientation);
+
+		auto isNearBone = [](const LeapBone& a, const LeapBone& b)
+		{
+			return isNear(a.mPrevJoint, b.mPrevJoint) && isNear(a.mNextJoint, b.mNextJoint) &&
+				isNear(a.mRotation, b.mRotation);
+		};
+
+		for (UINT32 i = 0; i < 5; i++)
+		{
+			for (UINT32 j = 0; j < 4; j++)
+				near = near && isNearBone(a.mDigits[i].mBones[j], b.mDigits[i].mBones[j]);
+		}
+
+		return near && isNearBone(a.mArm, b.mArm);
+	}
+}
+
+LeapFrameUtilityTestSuite::LeapFrameUtilityTestSuite()
+{
+	BS_ADD_TEST(LeapFrameUtilityTestSuite::frameTransformAffineMatchesScalar)
+	BS_ADD_TEST(LeapFrameUtilityTestSuite::frameTransformUniformScaleMatchesScalar)
+	BS_ADD_TEST(LeapFrameUtilityTestSuite::frameTransformTranslateMatchesScalar)
+	BS_ADD_TEST(LeapFrameUtilityTestSuite::frameTransformIdentityLeavesHands)
+}
+
+void LeapFrameUtilityTestSuite::frameTransformAffineMatchesScalar()
+{
+	Transform transform(Vector3(0.5f, -1.0f, 2.0f), makeRotation(0.1f, 0.7f, -0.3f, 0.6f), Vector3(0.01f, 0.02f, 0.015f));
+	checkMatchesScalar(transform, LeapTransformKind::Affine);
+}
+
+void LeapFrameUtilityTestSuite::frameTransformUniformScaleMatchesScalar()
+{
+	Transform transform(Vector3(0.5f, -1.0f, 2.0f), Quaternion::IDENTITY, Vector3(0.01f, 0.01f, 0.01f));
+	checkMatchesScalar(transform, LeapTransformKind::TranslateUniformScale);
+}
+
+void LeapFrameUtilityTestSuite::frameTransformTranslateMatchesScalar()
+{
+	Transform transform(Vector3(0.5f, -1.0f, 2.0f), Quaternion::IDENTITY, Vector3::ONE);
+	checkMatchesScalar(transform, LeapTransformKind::Translate);
+}
+
+void LeapFrameUtilityTestSuite::frameTransformIdentityLeavesHands()
+{
+	Transform transform(Vector3::ZERO, Quaternion::IDENTITY, Vector3::ONE);
+	checkMatchesScalar(transform, LeapTransformKind::Identity);
+}
+
+void LeapFrameUtilityTestSuite::checkMatchesScalar(const Transform& transform, LeapTransformKind expectedKind)
+{
+	BS_TEST_ASSERT(LeapFrameUtility::getTransformKind(transform) == expectedKind);
+
+	LeapHand batched[NUM_HANDS];
+	LeapHand scalar[NUM_HANDS];
+	makeHands(batched, NUM_HANDS);
+	makeHands(scalar, NUM_HANDS);
+
+	LeapFrame frame;
+	std::memset(&frame, 0, sizeof(frame));
+	frame.mNumberOfHands = NUM_HANDS;
+	frame.mHands = batched;
+
+	LeapFrameUtility::transform(&frame, transform);
+
+	for (UINT32 i = 0; i < NUM_HANDS; i++)
+	{
+		transformScalar(scalar[i], transform);
+		BS_TEST_ASSERT(isNear(batched[i], scalar[i]));
+
+		// Members the transformation doesn't cover are left alone
+		BS_TEST_ASSERT(batched[i].mId == i);
+	}
+}
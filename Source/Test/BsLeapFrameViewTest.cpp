@@ -0,0 +1,59 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "BsLeapTestSuite.h"
+#include "Leap/BsLeapFrameView.h"
+#include "Scene/BsTransform.h"
+
+using namespace bs;
+
+namespace
+{
+	/** Largest difference accepted between the view and the batched transformation. */
+	constexpr float TOLERANCE = 1e-4f;
+
+	bool isNear(const Vector3& a, const Vector3& b)
+	{
+		return (a - b).length() <= TOLERANCE;
+	}
+}
+
+LeapFrameViewTestSuite::LeapFrameViewTestSuite()
+{
+	BS_ADD_TEST(LeapFrameViewTestSuite::frameViewKeepsNormalPerpendicular)
+}
+
+void LeapFrameViewTestSuite::frameViewKeepsNormalPerpendicular()
+{
+	LeapHand hands[1];
+	LeapFrame frame;
+	makeFrame(frame, hands, 1, 1);
+
+	// A tilted palm, whose normal and direction are perpendicular
+	hands[0].mPalm.mNormal = Vector3::normalize(Vector3(0.0f, -1.0f, 1.0f));
+	hands[0].mPalm.mDirection = Vector3::normalize(Vector3(0.0f, 1.0f, 1.0f));
+
+	// Stretching along y tilts the direction, the normal must follow to stay perpendicular
+	Quaternion rotation;
+	rotation.x = 0.0f;
+	rotation.y = 0.0f;
+	rotation.z = std::sin(0.25f);
+	rotation.w = std::cos(0.25f);
+	Transform transform(Vector3(0.5f, -1.0f, 2.0f), rotation, Vector3(0.01f, 0.03f, 0.01f));
+
+	LeapFrameView view;
+	view.reset(&frame, transform, 1);
+	const LeapPalm& palm = view.getPalm(0);
+
+	BS_TEST_ASSERT(std::abs(palm.mNormal.dot(palm.mDirection)) <= TOLERANCE);
+	BS_TEST_ASSERT(std::abs(palm.mNormal.length() - 1.0f) <= TOLERANCE);
+
+	// Same result as transforming the whole frame up front
+	LeapHand transformed = hands[0];
+	LeapFrame transformedFrame = frame;
+	transformedFrame.mHands = &transformed;
+	LeapFrameUtility::transform(&transformedFrame, transform);
+
+	BS_TEST_ASSERT(isNear(palm.mNormal, transformed.mPalm.mNormal));
+	BS_TEST_ASSERT(isNear(palm.mDirection, transformed.mPalm.mDirection));
+}
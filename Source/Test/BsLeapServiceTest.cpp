@@ -0,0 +1,180 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "BsLeapTestSuite.h"
+#include "Leap/BsLeapFramePool.h"
+#include "Leap/BsLeapFrameView.h"
+#include "Leap/BsLeapService.h"
+#include "Scene/BsTransform.h"
+
+#include <cstdlib>
+#include <new>
+
+using namespace bs;
+
+namespace
+{
+	/** Number of calls to operator new made by the current thread. */
+	thread_local UINT64 sNumNewCalls = 0;
+
+	/** Returns the number of heap allocations made by the current thread so far. */
+	UINT64 getNumAllocations()
+	{
+		// The bsf allocators only count in builds with profiling enabled, operator new always does
+		return sNumNewCalls + MemoryCounter::getNumAllocs();
+	}
+
+	/** Publishes @p source transformed into a pooled snapshot, the way CLeapServiceProvider::_transformFrame() does. */
+	void transformFrame(LeapFramePool& pool, const LeapFrameAlloc& source, const Transform& transform,
+		LeapFrameRef& dest)
+	{
+		LeapFrameRef snapshot = pool.acquire();
+		LeapFrameAlloc& frame = snapshot._getWritable();
+
+		frame = source;
+		LeapFrameUtility::transform(frame.get(), transform);
+
+		dest = std::move(snapshot);
+	}
+}
+
+// Replaced for the whole test executable, so that allocations made by the tested code can be counted
+void* operator new(std::size_t size)
+{
+	sNumNewCalls++;
+
+	void* ptr = std::malloc(size != 0 ? size : 1);
+	if (ptr == nullptr)
+		throw std::bad_alloc();
+
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+LeapServiceTestSuite::LeapServiceTestSuite()
+{
+	BS_ADD_TEST(LeapServiceTestSuite::serviceFrameHistoryAfterWrap)
+	BS_ADD_TEST(LeapServiceTestSuite::serviceProviderCycleDoesNotAllocate)
+}
+
+void LeapServiceTestSuite::startUp()
+{
+	// Never connected, frames are injected instead
+	LeapService::startUp();
+}
+
+void LeapServiceTestSuite::shutDown()
+{
+	LeapService::shutDown();
+}
+
+void LeapServiceTestSuite::serviceFrameHistoryAfterWrap()
+{
+	// Wraps the 60 frame history several times, with a varying number of hands
+	LeapHand hands[2];
+	LeapFrame frame;
+	for (INT64 id = 0; id < 200; id++)
+	{
+		makeFrame(frame, hands, 1 + (UINT32)(id % 2), id);
+		gLeapService()._injectTrackingEvent(reinterpret_cast<const LEAP_TRACKING_EVENT*>(&frame));
+
+		// LeapC reuses its message memory once the event is handled
+		std::memset(hands, 0xFF, sizeof(hands));
+	}
+
+	LeapFrameAlloc copy;
+	BS_TEST_ASSERT(gLeapService().getFrame(&copy, 0));
+	BS_TEST_ASSERT(copy.get()->mInfo.frame_id == 199);
+	BS_TEST_ASSERT(copy.get()->mNumberOfHands == 2);
+	BS_TEST_ASSERT(copy.get()->mHands[1].mId == 1991);
+
+	// The oldest frame still stored, with its own hands rather than those of the frame that replaced it
+	BS_TEST_ASSERT(gLeapService().getFrame(&copy, 59));
+	BS_TEST_ASSERT(copy.get()->mInfo.frame_id == 140);
+	BS_TEST_ASSERT(copy.get()->mNumberOfHands == 1);
+	BS_TEST_ASSERT(copy.get()->mHands[0].mId == 1400);
+	BS_TEST_ASSERT(copy.get()->mHands[0].mPalm.mPosition == Vector3(140.0f, 0.0f, 0.0f));
+	BS_TEST_ASSERT(gLeapService().getFrameTimestamp(59) == 14000);
+
+	BS_TEST_ASSERT(!gLeapService().hasFrame(60));
+	BS_TEST_ASSERT(!gLeapService().getFrame(&copy, 60));
+}
+
+void LeapServiceTestSuite::serviceProviderCycleDoesNotAllocate()
+{
+	constexpr UINT32 NUM_WARMUP_TICKS = 100;
+	constexpr UINT32 NUM_TICKS = 1000;
+
+	// CLeapServiceProvider needs a scene object and a streaming device, so its update() and fixedUpdate() are replayed
+	// here with the same members, set up the way initializeService() does
+	LeapService& leap = gLeapService();
+	UINT32 maxHands = leap.getMaxHands();
+
+	LeapFrameAlloc untransformedUpdateFrame;
+	LeapFrameAlloc untransformedFixedFrame;
+	untransformedUpdateFrame.reserveNumberOfHands(maxHands);
+	untransformedFixedFrame.reserveNumberOfHands(maxHands);
+
+	LeapFramePool framePool;
+	framePool.reserveNumberOfHands(maxHands);
+
+	LeapFrameInterpolator updateInterpolator;
+	LeapFrameInterpolator fixedInterpolator;
+	LeapFramePredictor predictor;
+	LeapFrameView updateFrameView;
+	LeapFrameRef transformedUpdateFrame;
+	LeapFrameRef transformedFixedFrame;
+
+	// Non-uniform scale, so frames go through the most general transformation
+	Transform transform(Vector3(0.0f, 1.0f, 0.5f), Quaternion::IDENTITY, Vector3(0.001f, 0.002f, 0.001f));
+
+	// Continues after the frames pushed by the previous tests
+	INT64 firstId = (INT64)leap.getFrameTimestamp() / 100 + 1;
+
+	LeapHand hands[2];
+	LeapFrame frame;
+	bool success = true;
+	UINT64 numAllocations = 0;
+	for (UINT32 tick = 0; tick < NUM_WARMUP_TICKS + NUM_TICKS; tick++)
+	{
+		if (tick == NUM_WARMUP_TICKS)
+			numAllocations = getNumAllocations();
+
+		// The message pump thread, with a hand entering and leaving
+		makeFrame(frame, hands, tick % 3, firstId + tick);
+		leap._injectTrackingEvent(reinterpret_cast<const LEAP_TRACKING_EVENT*>(&frame));
+
+		// Consumers like hand models hold on to the previous frames until they get the new ones
+		LeapFrameRef heldUpdateFrame = transformedUpdateFrame;
+		LeapFrameRef heldFixedFrame = transformedFixedFrame;
+
+		// Fixed update, then update, both sampling the time between the two newest frames
+		INT64 newest = leap.getFrameTimestamp();
+		success &= leap.getFrameAt(newest - 30, &untransformedFixedFrame, fixedInterpolator);
+		transformFrame(framePool, untransformedFixedFrame, transform, transformedFixedFrame);
+
+		success &= leap.getSharedFrameAt(newest - 50, tick, &untransformedUpdateFrame, updateInterpolator);
+		updateFrameView.reset(untransformedUpdateFrame.get(), transform, tick);
+		if (updateFrameView.getNumHands() > 0)
+			updateFrameView.getHand(0);
+
+		transformFrame(framePool, untransformedUpdateFrame, transform, transformedUpdateFrame);
+
+		// Prediction, used by providers compensating for latency instead of interpolating
+		success &= leap.getPredictedFrame(newest + 20, &untransformedUpdateFrame, predictor);
+	}
+
+	// Counted before asserting, as assertions allocate the strings describing them
+	numAllocations = getNumAllocations() - numAllocations;
+	BS_TEST_ASSERT(numAllocations == 0);
+	BS_TEST_ASSERT(success);
+}
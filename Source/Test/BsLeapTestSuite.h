@@ -0,0 +1,119 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Leap/BsLeapPrerequisites.h"
+#include "Leap/BsLeapFrameUtility.h"
+#include "Testing/BsTestSuite.h"
+
+#include <cstring>
+
+namespace bs
+{
+	/**
+	 * Fills @p frame with @p numHands hands from @p hands, tagging everything with @p id. The frame is timestamped
+	 * id * 100 and every palm is placed at (id, index of the hand, 0).
+	 */
+	inline void makeFrame(LeapFrame& frame, LeapHand* hands, UINT32 numHands, INT64 id)
+	{
+		std::memset(&frame, 0, sizeof(frame));
+		frame.mInfo.frame_id = id;
+		frame.mInfo.timestamp = id * 100;
+		frame.mTrackingFrameId = id;
+		frame.mNumberOfHands = numHands;
+		frame.mHands = hands;
+
+		for (UINT32 i = 0; i < numHands; i++)
+		{
+			std::memset(&hands[i], 0, sizeof(LeapHand));
+			hands[i].mId = (UINT32)(id * 10 + i);
+			hands[i].mPalm.mPosition = Vector3((float)id, (float)i, 0.0f);
+		}
+	}
+
+	/** Runs the tests of every part of the Leap plugin. */
+	class LeapTestSuite : public TestSuite
+	{
+	public:
+		LeapTestSuite();
+	};
+
+	/** Tests BoundedQueue, the single producer single consumer queue used to pass events between threads. */
+	class BoundedQueueTestSuite : public TestSuite
+	{
+	public:
+		BoundedQueueTestSuite();
+
+	private:
+		void boundedQueueRoundsCapacity();
+		void boundedQueueFullAndEmpty();
+		void boundedQueueWrapsAround();
+		void boundedQueueAcrossThreads();
+	};
+
+	/** Tests LeapFrameAlloc. */
+	class LeapFrameAllocTestSuite : public TestSuite
+	{
+	public:
+		LeapFrameAllocTestSuite();
+
+	private:
+		void frameAllocCopiesIntoOwnBuffer();
+		void frameAllocReusesBufferAcrossFrames();
+		void frameAllocReusesBufferAcrossHistoryReads();
+	};
+
+	/** Tests LeapFrameHistory. */
+	class LeapFrameHistoryTestSuite : public TestSuite
+	{
+	public:
+		LeapFrameHistoryTestSuite();
+
+	private:
+		void frameHistoryOwnsHands();
+		void frameHistoryDropsHandsPastMaximum();
+		void frameHistoryReadAfterWrap();
+		void frameHistoryBracketsTimestamps();
+	};
+
+	/** Tests the batched frame transformation of LeapFrameUtility against a member by member reference. */
+	class LeapFrameUtilityTestSuite : public TestSuite
+	{
+	public:
+		LeapFrameUtilityTestSuite();
+
+	private:
+		void frameTransformAffineMatchesScalar();
+		void frameTransformUniformScaleMatchesScalar();
+		void frameTransformTranslateMatchesScalar();
+		void frameTransformIdentityLeavesHands();
+
+		/** Transforms the same hands through LeapFrameUtility and one member at a time, and compares the results. */
+		void checkMatchesScalar(const Transform& transform, LeapTransformKind expectedKind);
+	};
+
+	/** Tests LeapFrameView. */
+	class LeapFrameViewTestSuite : public TestSuite
+	{
+	public:
+		LeapFrameViewTestSuite();
+
+	private:
+		void frameViewKeepsNormalPerpendicular();
+	};
+
+	/** Tests LeapService without a connection, with tracking events injected as if received from LeapC. */
+	class LeapServiceTestSuite : public TestSuite
+	{
+	public:
+		LeapServiceTestSuite();
+
+	protected:
+		void startUp() override;
+		void shutDown() override;
+
+	private:
+		void serviceFrameHistoryAfterWrap();
+		void serviceProviderCycleDoesNotAllocate();
+	};
+}
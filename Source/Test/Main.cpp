@@ -0,0 +1,47 @@
+//************************************ bs::framework - Copyright 2018 Next Limit *****************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+
+#include "BsLeapTestSuite.h"
+#include "Testing/BsConsoleTestOutput.h"
+
+namespace bs
+{
+	/** Prints failed assertions like ConsoleTestOutput, and counts them so the process can report the failure. */
+	class LeapTestOutput : public ConsoleTestOutput
+	{
+	public:
+		void outputFail(const String& desc, const String& function, const String& file, long line) override
+		{
+			ConsoleTestOutput::outputFail(desc, function, file, line);
+			mNumFailures++;
+		}
+
+		/** Returns the number of assertions that failed so far. */
+		UINT32 getNumFailures() const { return mNumFailures; }
+
+	private:
+		UINT32 mNumFailures = 0;
+	};
+
+	LeapTestSuite::LeapTestSuite()
+	{
+		add(create<BoundedQueueTestSuite>());
+		add(create<LeapFrameAllocTestSuite>());
+		add(create<LeapFrameHistoryTestSuite>());
+		add(create<LeapFrameUtilityTestSuite>());
+		add(create<LeapFrameViewTestSuite>());
+		add(create<LeapServiceTestSuite>());
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	SPtr<TestSuite> tests = TestSuite::create<LeapTestSuite>();
+
+	LeapTestOutput output;
+	tests->run(output);
+
+	return output.getNumFailures() == 0 ? 0 : 1;
+}